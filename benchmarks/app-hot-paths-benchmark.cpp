@@ -0,0 +1,290 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "security-toy-client-app.hpp"
+#include "evil-producer-app.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include <vector>
+
+//Microbenchmark of the app hot paths (EvilProducerApp::OnInterest, SecurityToyClientApp::SendPacket,
+//OnData and ScheduleNextPacket). The handlers are called directly with synthetic Interests/Data.
+//
+//Stub face: each app sits alone on its own node (no links) with the multicast strategy, so what the
+//handlers push into their face ends right there: Interests have no route and are rejected, Data is
+//unsolicited and dropped. The simulator is only run between batches to flush those PIT timers.
+//
+//Output is ns/call (median and min over the repeats), allocations/call and calls/s. Build with
+//./waf configure --with-benchmarks and run ./build/app-hot-paths-benchmark [--iterations=N --repeats=N]
+
+static uint64_t g_allocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  g_allocations++;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace ns3 {
+namespace ndn {
+
+//swallows the per-packet cout output of the handlers while they are being timed
+class NullBuffer : public std::streambuf
+{
+  protected:
+     virtual int_type
+     overflow(int_type c)
+     {
+       return traits_type::not_eof(c);
+     }
+};
+
+//gives the benchmark access to the protected consumer state
+class ClientProbe : public SecurityToyClientApp
+{
+  public:
+     using SecurityToyClientApp::ScheduleNextPacket;
+
+     //forget everything the previous batch left behind so every batch starts from the same state
+     void
+     Reset()
+     {
+       RemoveSendEvent();
+       m_seqTimeouts.clear();
+       m_seqFullDelay.clear();
+       m_seqLastDelay.clear();
+       m_seqRetxCounts.clear();
+       m_retxSeqs.clear();
+       m_verificationMode = false;
+       m_pursuitMode = false;
+       m_firstTime = false;
+       m_seq = 1;
+       //as after a SendPacket: the Data's extra component sits right after this name
+       m_originalInterestName = m_interestName;
+       m_originalInterestName.appendSequenceNumber(0);
+     }
+
+     void
+     RemoveSendEvent()
+     {
+       if (m_sendEvent.IsRunning())
+         Simulator::Remove(m_sendEvent);
+     }
+};
+
+struct Result
+{
+  std::string name;
+  double medianNs;
+  double minNs;
+  double allocsPerCall;
+};
+
+//times `repeats` batches of `iterations` calls; setup runs before each batch and is not timed
+template<class Setup, class Body>
+Result
+Measure(const std::string& name, uint32_t iterations, uint32_t repeats, Setup setup, Body body)
+{
+  NullBuffer nullBuffer;
+  std::vector<double> perCall;
+  uint64_t allocations = 0;
+
+  for (uint32_t r = 0; r < repeats; r++) {
+    setup();
+
+    std::streambuf* old = std::cout.rdbuf(&nullBuffer);
+    uint64_t allocsBefore = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+      body(i);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    allocations += g_allocations - allocsBefore;
+    std::cout.rdbuf(old);
+
+    perCall.push_back(std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+  }
+
+  std::sort(perCall.begin(), perCall.end());
+  Result result;
+  result.name = name;
+  result.medianNs = perCall[perCall.size() / 2];
+  result.minNs = perCall.front();
+  result.allocsPerCall = static_cast<double>(allocations) / (static_cast<double>(iterations) * repeats);
+  return result;
+}
+
+//lets the events queued by the last batch (PIT expiry etc.) run out
+static void
+Flush()
+{
+  Simulator::Stop(Seconds(10.0));
+  Simulator::Run();
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t iterations = 20000;
+  uint32_t repeats = 9;
+
+  CommandLine cmd;
+  cmd.AddValue("iterations", "Calls per timed batch", iterations);
+  cmd.AddValue("repeats", "Timed batches per handler (the median is reported)", repeats);
+  cmd.Parse(argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Freshness::Lru");
+  ndnHelper.InstallAll();
+  StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/multicast");
+
+  std::string dataPrefix = "/prefix/data";
+  std::string keyPrefix = "/prefix/key";
+
+  Ptr<ClientProbe> client = CreateObject<ClientProbe>();
+  client->SetAttribute("Prefix", StringValue(dataPrefix));
+  client->SetAttribute("KeyName", StringValue(keyPrefix));
+  client->SetAttribute("WaitTime", StringValue("1.0"));
+  client->SetAttribute("ReactionTime", StringValue("0.5"));
+  nodes.Get(0)->AddApplication(client);
+
+  Ptr<EvilProducerApp> evil = CreateObject<EvilProducerApp>();
+  evil->SetAttribute("Prefix", StringValue(dataPrefix));
+  evil->SetAttribute("PayloadSize", StringValue("1000"));
+  nodes.Get(1)->AddApplication(evil);
+
+  //start both apps
+  Simulator::Stop(Seconds(0.001));
+  Simulator::Run();
+
+  //synthetic packets, built once so only the handlers are timed: good Data is bigger than the client's
+  //GoodDataSize (1024), evil Data looks like EvilProducerApp's (/evil component, smaller payload)
+  std::vector<shared_ptr<const Interest>> interests;
+  std::vector<shared_ptr<const Data>> goodDatas;
+  std::vector<shared_ptr<const Data>> evilDatas;
+  for (uint32_t i = 0; i < iterations; i++) {
+    Name name(dataPrefix);
+    name.appendSequenceNumber(i + 1);
+
+    auto interest = make_shared<Interest>(name);
+    interest->setNonce(i);
+    interest->wireEncode();
+    interests.push_back(interest);
+
+    auto good = make_shared<Data>(name);
+    good->setContent(make_shared< ::ndn::Buffer>(2048));
+    good->setSignature(Signature(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                                 ::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0)));
+    good->wireEncode();
+    goodDatas.push_back(good);
+
+    auto evil = make_shared<Data>(Name(name).append("evil"));
+    evil->setContent(make_shared< ::ndn::Buffer>(1000));
+    evil->setSignature(Signature(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                                 ::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0)));
+    evil->wireEncode();
+    evilDatas.push_back(evil);
+  }
+
+  auto key = make_shared<Data>(Name(keyPrefix));
+  key->setContent(make_shared< ::ndn::Buffer>(1024));
+  key->setSignature(Signature(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                              ::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0)));
+  key->wireEncode();
+
+  std::vector<Result> results;
+
+  results.push_back(Measure("EvilProducerApp::OnInterest", iterations, repeats,
+                            [] { Flush(); },
+                            [&] (uint32_t i) { evil->OnInterest(interests[i]); }));
+
+  results.push_back(Measure("SecurityToyClientApp::SendPacket", iterations, repeats,
+                            [&] { Flush(); client->Reset(); },
+                            [&] (uint32_t) { client->SendPacket(); }));
+
+  //each iteration is one data + key pair, so the pair is what gets timed
+  results.push_back(Measure("SecurityToyClientApp::OnData (good data + key)", iterations, repeats,
+                            [&] { Flush(); client->Reset(); },
+                            [&] (uint32_t i) { client->OnData(goodDatas[i]); client->OnData(key); }));
+
+  results.push_back(Measure("SecurityToyClientApp::OnData (evil data + key)", iterations, repeats,
+                            [&] { Flush(); client->Reset(); },
+                            [&] (uint32_t i) { client->OnData(evilDatas[i]); client->OnData(key); }));
+
+  results.push_back(Measure("SecurityToyClientApp::ScheduleNextPacket (+ remove)", iterations, repeats,
+                            [&] { Flush(); client->Reset(); },
+                            [&] (uint32_t) { client->ScheduleNextPacket(); client->RemoveSendEvent(); }));
+
+  std::cout << std::left << std::setw(54) << "Handler"
+            << std::right << std::setw(12) << "ns/call" << std::setw(12) << "min ns"
+            << std::setw(14) << "allocs/call" << std::setw(14) << "calls/s" << std::endl;
+  for (const Result& r : results) {
+    std::cout << std::left << std::setw(54) << r.name << std::right << std::fixed
+              << std::setw(12) << std::setprecision(1) << r.medianNs
+              << std::setw(12) << std::setprecision(1) << r.minNs
+              << std::setw(14) << std::setprecision(2) << r.allocsPerCall
+              << std::setw(14) << std::setprecision(0) << 1e9 / r.medianNs << std::endl;
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::ndn::main(argc, argv);
+}
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "anomaly-prefilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+//smallest deviations used: half a hop, a millisecond, a byte
+static const double HOP_FLOOR = 0.5;
+static const double RTT_FLOOR = 0.001;
+static const double SIZE_FLOOR = 1.0;
+
+AnomalyPrefilter::RunningStats::RunningStats()
+  : count(0)
+  , mean(0)
+  , m2(0)
+{
+}
+
+void
+AnomalyPrefilter::RunningStats::Add(double value)
+{
+   count++;
+   double delta = value - mean;
+   mean += delta / count;
+   m2 += delta * (value - mean);
+}
+
+double
+AnomalyPrefilter::RunningStats::GetDeviation(double floor) const
+{
+   double deviation = count > 1 ? std::sqrt(m2 / (count - 1)) : 0;
+   return std::max(deviation, floor);
+}
+
+AnomalyPrefilter::AnomalyPrefilter()
+{
+}
+
+void
+AnomalyPrefilter::Learn(const Features& features)
+{
+   m_hops.Add(features.hopCount);
+   m_rtt.Add(features.rtt);
+   m_size.Add(features.size);
+}
+
+double
+AnomalyPrefilter::Score(const Features& features) const
+{
+   double closer = std::max(0.0, m_hops.mean - features.hopCount) / m_hops.GetDeviation(HOP_FLOOR);
+   double faster = std::max(0.0, m_rtt.mean - features.rtt) / m_rtt.GetDeviation(RTT_FLOOR);
+   double resized = std::fabs(features.size - m_size.mean) / m_size.GetDeviation(SIZE_FLOOR);
+   return closer + faster + resized;
+}
+
+bool
+AnomalyPrefilter::IsWarm(uint32_t minSamples) const
+{
+   return m_hops.count >= minSamples;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef ANOMALYPREFILTER_H
+#define ANOMALYPREFILTER_H
+
+#include <cstdint>
+
+namespace ns3 {
+namespace ndn {
+
+//Scores how unusual a Data looks next to the Data that passed verification so far.
+//
+//The poisoning scenarios' attacker sits fewer hops away than the producer, so its Data comes in over fewer hops,
+//sooner after the Interest than usual, and with a different size. The score adds up, in standard deviations of
+//the verified Data: missing hops, missing round trip time and size difference in either direction (only being
+//closer/faster counts for hops and RTT). Deviations have a floor, so a perfectly steady history does not make
+//every tiny change look infinite.
+class AnomalyPrefilter
+{
+  public:
+     struct Features
+     {
+       double hopCount;
+       double rtt; //seconds from (re)sending the Interest to the Data
+       double size; //content bytes
+     };
+
+     AnomalyPrefilter();
+
+     //a Data that passed verification
+     void
+     Learn(const Features& features);
+
+     //0 = looks like the verified Data, larger = more unusual
+     double
+     Score(const Features& features) const;
+
+     //seen enough verified Data for the score to mean something
+     bool
+     IsWarm(uint32_t minSamples) const;
+
+  private:
+     //Welford's running mean and variance
+     struct RunningStats
+     {
+       RunningStats();
+
+       void
+       Add(double value);
+
+       //standard deviation, at least floor
+       double
+       GetDeviation(double floor) const;
+
+       uint64_t count;
+       double mean;
+       double m2;
+     };
+
+     RunningStats m_hops;
+     RunningStats m_rtt;
+     RunningStats m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
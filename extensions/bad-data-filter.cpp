@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "bad-data-filter.hpp"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.BadDataFilter");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(BadDataFilter);
+
+static const uint8_t COUNTER_MAX = 15;
+
+TypeId
+BadDataFilter::GetTypeId()
+{
+   static TypeId tid = TypeId("ns3::ndn::BadDataFilter")
+     .SetGroupName("Ndn")
+     .SetParent<Object>()
+     .AddConstructor<BadDataFilter>()
+     .AddAttribute("Cells", "Number of 4 bit counters", UintegerValue(65536),
+                   MakeUintegerAccessor(&BadDataFilter::m_cells), MakeUintegerChecker<uint32_t>(2))
+     .AddAttribute("Hashes", "Counters probed per digest", UintegerValue(4),
+                   MakeUintegerAccessor(&BadDataFilter::m_hashes), MakeUintegerChecker<uint32_t>(1, 16))
+     .AddAttribute("ReportStats", "Print entries, hits, false positive estimate and memory at the end",
+                   BooleanValue(false), MakeBooleanAccessor(&BadDataFilter::m_reportStats),
+                   MakeBooleanChecker());
+   return tid;
+}
+
+BadDataFilter::BadDataFilter()
+  : m_cells(65536)
+  , m_hashes(4)
+  , m_occupied(0)
+  , m_reportStats(false)
+  , m_nodeId(0)
+  , m_inserted(0)
+  , m_probes(0)
+  , m_hits(0)
+{
+}
+
+Ptr<BadDataFilter>
+BadDataFilter::Get(Ptr<Node> node)
+{
+   Ptr<BadDataFilter> filter = node->GetObject<BadDataFilter>();
+   if(filter == 0)
+   {
+     filter = CreateObject<BadDataFilter>();
+     filter->m_nodeId = node->GetId();
+     filter->m_counters.assign((filter->m_cells + 1) / 2, 0); //attributes are set by now
+     node->AggregateObject(filter);
+   }
+   return filter;
+}
+
+uint32_t
+BadDataFilter::GetCell(const name::Component& digest, uint32_t i) const
+{
+   NS_ASSERT_MSG(digest.value_size() >= 8, "not a digest: " << digest);
+
+   uint32_t h1, h2;
+   std::memcpy(&h1, digest.value(), sizeof(h1));
+   std::memcpy(&h2, digest.value() + sizeof(h1), sizeof(h2));
+   h2 |= 1; //odd, so the probes do not collapse onto one cell
+   return (h1 + i * h2) % m_cells;
+}
+
+uint8_t
+BadDataFilter::GetCounter(uint32_t cell) const
+{
+   uint8_t byte = m_counters[cell / 2];
+   return (cell % 2 == 0) ? (byte & 0x0f) : (byte >> 4);
+}
+
+void
+BadDataFilter::SetCounter(uint32_t cell, uint8_t value)
+{
+   uint8_t& byte = m_counters[cell / 2];
+   if(cell % 2 == 0)
+   {
+     byte = (byte & 0xf0) | value;
+   }
+   else
+   {
+     byte = (byte & 0x0f) | (value << 4);
+   }
+}
+
+void
+BadDataFilter::Insert(const name::Component& digest)
+{
+   for(uint32_t i = 0; i < m_hashes; i++)
+   {
+     uint32_t cell = GetCell(digest, i);
+     uint8_t counter = GetCounter(cell);
+     if(counter == 0)
+     {
+       m_occupied++;
+     }
+     if(counter < COUNTER_MAX)
+     {
+       SetCounter(cell, counter + 1);
+     }
+   }
+   m_inserted++;
+   NS_LOG_DEBUG("node(" << m_nodeId << ") bad digest " << digest.toUri());
+}
+
+bool
+BadDataFilter::Contains(const name::Component& digest)
+{
+   m_probes++;
+   for(uint32_t i = 0; i < m_hashes; i++)
+   {
+     if(GetCounter(GetCell(digest, i)) == 0)
+       return false;
+   }
+   m_hits++;
+   return true;
+}
+
+double
+BadDataFilter::GetEstimatedFalsePositiveRate() const
+{
+   return std::pow(double(m_occupied) / m_cells, double(m_hashes));
+}
+
+size_t
+BadDataFilter::GetMemoryBytes() const
+{
+   return m_counters.size();
+}
+
+void
+BadDataFilter::DoDispose()
+{
+   if(m_reportStats && m_inserted > 0)
+   {
+     std::cout << "BadDataFilter node(" << m_nodeId << "): inserted=" << m_inserted
+               << " probes=" << m_probes << " hits=" << m_hits
+               << " occupied-cells=" << m_occupied << "/" << m_cells
+               << " est-false-positive-rate=" << GetEstimatedFalsePositiveRate()
+               << " memory-bytes=" << GetMemoryBytes() << std::endl;
+   }
+   m_counters.clear();
+   Object::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
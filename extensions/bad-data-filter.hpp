@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef BADDATAFILTER_H
+#define BADDATAFILTER_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/object.h"
+#include "ns3/node.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+//Per-node counting Bloom filter of the implicit digests of Data found to be bad.
+//
+//The consumers put every Data that fails verification in; a Data whose digest is (probably) in the filter
+//is dropped after Hashes probes, without fetching the key again. Cells are 4 bit counters (two per byte); a
+//counter that reached 15 stays there. There is no Remove: a false positive would have it take other digests'
+//counts out, and nothing here ever needs a bad digest to become good again. The probe positions come
+//straight from the digest (it is already a SHA-256), by double hashing two of its words.
+//Aggregated to the node on first use, so the node's consumers, and anything else on the node that wants to
+//know (e.g. a forwarding strategy), share it.
+class BadDataFilter : public Object
+{
+  public:
+     static TypeId
+     GetTypeId();
+
+     BadDataFilter();
+
+     //the node's filter, created and aggregated the first time someone asks
+     static Ptr<BadDataFilter>
+     Get(Ptr<Node> node);
+
+     //digest = the implicit SHA-256 digest component of the Data (Data::getFullName().get(-1))
+     void
+     Insert(const name::Component& digest);
+
+     //false positives possible (see GetEstimatedFalsePositiveRate), false negatives not
+     bool
+     Contains(const name::Component& digest);
+
+     //(occupied cells / cells) ^ hashes
+     double
+     GetEstimatedFalsePositiveRate() const;
+
+     size_t
+     GetMemoryBytes() const;
+
+  protected:
+     virtual void
+     DoDispose();
+
+  private:
+     //cell of the i-th probe
+     uint32_t
+     GetCell(const name::Component& digest, uint32_t i) const;
+
+     uint8_t
+     GetCounter(uint32_t cell) const;
+
+     void
+     SetCounter(uint32_t cell, uint8_t value);
+
+  private:
+     std::vector<uint8_t> m_counters; //cell 2i in the low nibble of byte i, 2i + 1 in the high one
+     uint32_t m_cells;
+     uint32_t m_hashes;
+     uint32_t m_occupied; //cells with a counter > 0
+     bool m_reportStats;
+     uint32_t m_nodeId;
+
+     uint64_t m_inserted;
+     uint64_t m_probes;
+     uint64_t m_hits;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+#include "common-random-streams.hpp"
+#include "security-toy-client-app.hpp"
+#include "evil-producer-app.hpp"
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.CommonRandomStreams");
+
+namespace ns3 {
+namespace ndn {
+
+const int64_t CommonRandomStreams::STREAMS_PER_APP;
+const int64_t CommonRandomStreams::APPS_PER_NODE;
+
+int64_t
+CommonRandomStreams::AssignAll(int64_t stream)
+{
+   const int64_t streamsPerNode = STREAMS_PER_APP * APPS_PER_NODE;
+
+   for(NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++)
+   {
+     //index by node id (not by creation order) so the same node gets the same streams in every variant
+     int64_t nodeBase = stream + (*node)->GetId() * streamsPerNode;
+
+     for(uint32_t i = 0; i < (*node)->GetNApplications() && i < APPS_PER_NODE; i++)
+     {
+       Ptr<Application> app = (*node)->GetApplication(i);
+       int64_t appBase = nodeBase + i * STREAMS_PER_APP;
+
+       Ptr<SecurityToyClientApp> consumer = DynamicCast<SecurityToyClientApp>(app);
+       if(consumer != 0)
+       {
+         consumer->AssignStreams(appBase);
+         NS_LOG_DEBUG("node(" << (*node)->GetId() << ") consumer app " << i << " on stream " << appBase);
+         continue;
+       }
+
+       Ptr<EvilProducerApp> evil = DynamicCast<EvilProducerApp>(app);
+       if(evil != 0)
+       {
+         evil->AssignStreams(appBase);
+         NS_LOG_DEBUG("node(" << (*node)->GetId() << ") evil app " << i << " on stream " << appBase);
+       }
+     }
+   }
+
+   return NodeList::GetNNodes() * streamsPerNode;
+}
+
+} // namespace ndn
+} // namespace ns3
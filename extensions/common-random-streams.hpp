@@ -0,0 +1,53 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+#ifndef COMMONRANDOMSTREAMS_H
+#define COMMONRANDOMSTREAMS_H
+
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+namespace ndn {
+
+//Common random numbers (CRN) for paired comparisons:
+//  ns-3 normally hands out RNG substreams in object creation order, so two variants of a scenario
+//  only share random draws if they happen to create every random variable in the same order.
+//  This pins the substreams of our own apps to the node they sit on instead, so a variant A and a
+//  variant B run with the same --RngRun draw the same Interest nonces, start jitter and attacker
+//  decisions on the same nodes.
+class CommonRandomStreams
+{
+  public:
+     //assigns streams to every SecurityToyClientApp and EvilProducerApp currently installed
+     //(call after the apps are installed and before Simulator::Run)
+     //returns the number of stream slots reserved (so callers can place other streams after them)
+     static int64_t
+     AssignAll(int64_t stream);
+
+     //stream slots reserved per node and per app on a node
+     static const int64_t STREAMS_PER_APP = 4;
+     static const int64_t APPS_PER_NODE = 4;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "counting-scheduler.hpp"
+#include "handler-profiler.hpp"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CountingScheduler");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CountingScheduler);
+
+TypeId
+CountingScheduler::GetTypeId()
+{
+   static TypeId tid = TypeId("ns3::ndn::CountingScheduler")
+     .SetParent<MapScheduler>()
+     .SetGroupName("Ndn")
+     .AddConstructor<CountingScheduler>()
+     .AddAttribute("Profile", "Time the app handlers and the scheduler and print where the wall-clock time went",
+                   BooleanValue(false),
+                   MakeBooleanAccessor(&CountingScheduler::SetProfile, &CountingScheduler::GetProfile),
+                   MakeBooleanChecker())
+     .AddAttribute("DepthInterval", "Simulated time between event queue depth samples (0 = do not sample)",
+                   TimeValue(Seconds(0)), MakeTimeAccessor(&CountingScheduler::m_depthInterval),
+                   MakeTimeChecker())
+     .AddAttribute("DepthFile", "File to write the queue depth samples to (empty = summary only)",
+                   StringValue(""), MakeStringAccessor(&CountingScheduler::m_depthFile),
+                   MakeStringChecker());
+   return tid;
+}
+
+CountingScheduler::CountingScheduler()
+  : m_scheduled(0)
+  , m_executed(0)
+  , m_removed(0)
+  , m_queued(0)
+  , m_peakQueued(0)
+  , m_finished(false)
+  , m_profile(false)
+  , m_nextDepthSample(0)
+{
+   NS_LOG_FUNCTION_NOARGS();
+}
+
+CountingScheduler::~CountingScheduler()
+{
+   double wall = std::chrono::duration<double>(m_lastEvent - m_firstEvent).count();
+
+   std::cerr << "CountingScheduler: scheduled=" << m_scheduled
+             << " executed=" << m_executed
+             << " removed=" << m_removed
+             << " peak-queue=" << m_peakQueued
+             << " run-wall-s=" << wall
+             << " events-per-s=" << (wall > 0 ? m_executed / wall : 0) << std::endl;
+
+   if(m_profile)
+   {
+     HandlerProfiler::Report(std::cerr, wall);
+   }
+
+   if(!m_depthSamples.empty())
+   {
+     ReportDepth(std::cerr);
+   }
+}
+
+void
+CountingScheduler::SetProfile(bool profile)
+{
+   m_profile = profile;
+   if(profile)
+   {
+     HandlerProfiler::Enable();
+   }
+}
+
+bool
+CountingScheduler::GetProfile() const
+{
+   return m_profile;
+}
+
+void
+CountingScheduler::ReportDepth(std::ostream& os) const
+{
+   uint64_t peak = 0;
+   double total = 0;
+   for(const auto& sample : m_depthSamples)
+   {
+     peak = std::max(peak, sample.second);
+     total += sample.second;
+   }
+
+   os << "Event queue depth: samples=" << m_depthSamples.size()
+      << " mean=" << total / m_depthSamples.size()
+      << " max=" << peak << std::endl;
+
+   if(!m_depthFile.empty())
+   {
+     std::ofstream out(m_depthFile.c_str());
+     out << "Time\tDepth\n";
+     for(const auto& sample : m_depthSamples)
+     {
+       out << TimeStep(sample.first).GetSeconds() << "\t" << sample.second << "\n";
+     }
+   }
+}
+
+void
+CountingScheduler::Insert(const Event& ev)
+{
+   HandlerProfiler::Scope scope(HandlerProfiler::SCHEDULER);
+   MapScheduler::Insert(ev);
+   m_scheduled++;
+   m_queued++;
+   if(m_queued > m_peakQueued)
+   {
+     m_peakQueued = m_queued;
+   }
+}
+
+void
+CountingScheduler::Finish()
+{
+   m_finished = true;
+}
+
+Scheduler::Event
+CountingScheduler::RemoveNext()
+{
+   if(m_finished)
+   {
+     //the simulator emptying the queue on destroy: none of these run
+     return MapScheduler::RemoveNext();
+   }
+
+   HandlerProfiler::Scope scope(HandlerProfiler::SCHEDULER);
+   m_lastEvent = std::chrono::steady_clock::now();
+   if(m_executed == 0)
+   {
+     m_firstEvent = m_lastEvent;
+     //destroy events run before the simulator drains its leftover events through RemoveNext
+     Simulator::ScheduleDestroy(&CountingScheduler::Finish, this);
+   }
+   m_executed++;
+   m_queued--;
+
+   Event ev = MapScheduler::RemoveNext();
+
+   if(!m_depthInterval.IsZero() && ev.key.m_ts >= m_nextDepthSample)
+   {
+     m_depthSamples.push_back(std::make_pair(ev.key.m_ts, m_queued));
+     m_nextDepthSample = ev.key.m_ts + m_depthInterval.GetTimeStep();
+   }
+   return ev;
+}
+
+void
+CountingScheduler::Remove(const Event& ev)
+{
+   HandlerProfiler::Scope scope(HandlerProfiler::SCHEDULER);
+   MapScheduler::Remove(ev);
+   m_removed++;
+   m_queued--;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef COUNTINGSCHEDULER_H
+#define COUNTINGSCHEDULER_H
+
+#include "ns3/map-scheduler.h"
+#include "ns3/nstime.h"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+//Map scheduler that also counts what goes through it, so a run can report its event rate.
+//
+//Opt in from the command line of any scenario (no scenario changes needed):
+//  --SchedulerType=ns3::ndn::CountingScheduler
+//When the simulator is destroyed it prints one line to stderr:
+//  CountingScheduler: scheduled=<n> executed=<n> removed=<n> peak-queue=<n> run-wall-s=<s> events-per-s=<n>
+//run-wall-s is the wall time between the first and the last executed event. Counting stops when the
+//simulator starts destroying itself, so the leftover events it drains then are not counted as executed.
+//
+//Profiling (--ns3::ndn::CountingScheduler::Profile=true) also turns on the HandlerProfiler and adds a
+//table of where the wall-clock time went (app handlers, forwarding from app faces, scheduler, rest).
+//DepthInterval samples the event queue depth every so many simulated seconds; the samples are
+//summarized in the table and written to DepthFile ("<time> <depth>" per line) when it is set.
+class CountingScheduler : public MapScheduler
+{
+  public:
+     static TypeId
+     GetTypeId();
+
+     CountingScheduler();
+
+     virtual ~CountingScheduler();
+
+     virtual void
+     Insert(const Event& ev);
+
+     virtual Event
+     RemoveNext();
+
+     virtual void
+     Remove(const Event& ev);
+
+  private:
+     void
+     SetProfile(bool profile);
+
+     bool
+     GetProfile() const;
+
+     void
+     ReportDepth(std::ostream& os) const;
+
+     //destroy event: the run is over, what RemoveNext hands out from now on is discarded, not executed
+     void
+     Finish();
+
+  private:
+     uint64_t m_scheduled; //events inserted
+     uint64_t m_executed; //events handed to the simulator to run
+     uint64_t m_removed; //events taken out again before they ran
+     uint64_t m_queued; //events currently in the queue
+     uint64_t m_peakQueued; //largest queue seen
+     bool m_finished; //simulator is being destroyed
+
+     std::chrono::steady_clock::time_point m_firstEvent;
+     std::chrono::steady_clock::time_point m_lastEvent;
+
+     bool m_profile;
+     Time m_depthInterval; //simulated time between queue depth samples (0 = no samples)
+     std::string m_depthFile;
+     uint64_t m_nextDepthSample; //timestamp (in time steps) of the next sample
+     std::vector<std::pair<uint64_t, uint64_t>> m_depthSamples; //(timestamp, queue depth)
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "crypto-cost-model.hpp"
+#include "scenario-registry.hpp"
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/security/digest-sha256.hpp>
+#include <ndn-cxx/security/v1/public-key.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CryptoCostModel");
+
+namespace ns3 {
+namespace ndn {
+
+static GlobalValue g_cryptoCostFile("CryptoCostFile",
+                                    "File the sign/verify calibrations are read from and appended to "
+                                    "(empty = calibrate in every run)",
+                                    StringValue(""), MakeStringChecker());
+
+static GlobalValue g_cryptoCostScale("CryptoCostScale",
+                                     "Factor applied to the host's sign/verify times (slower devices > 1)",
+                                     DoubleValue(1.0), MakeDoubleChecker<double>(0.0));
+
+static GlobalValue g_cryptoCostRounds("CryptoCostCalibrationRounds",
+                                      "Sign and verify calls timed per calibration",
+                                      UintegerValue(51), MakeUintegerChecker<uint32_t>(1));
+
+std::map<CryptoCostModel::Key, CryptoCostModel::Costs> CryptoCostModel::s_costs;
+bool CryptoCostModel::s_fileLoaded = false;
+
+static ScenarioRegistry::ResetHook g_resetHook(&CryptoCostModel::Reset);
+
+static double
+GetScale()
+{
+   DoubleValue scale;
+   g_cryptoCostScale.GetValue(scale);
+   return scale.Get();
+}
+
+Time
+CryptoCostModel::GetSignDelay(SigningKeyChain::Algorithm algorithm, uint32_t keySize)
+{
+   return NanoSeconds(static_cast<int64_t>(Calibrate(algorithm, keySize).signNs * GetScale()));
+}
+
+Time
+CryptoCostModel::GetVerifyDelay(SigningKeyChain::Algorithm algorithm, uint32_t keySize)
+{
+   return NanoSeconds(static_cast<int64_t>(Calibrate(algorithm, keySize).verifyNs * GetScale()));
+}
+
+const CryptoCostModel::Costs&
+CryptoCostModel::Calibrate(SigningKeyChain::Algorithm algorithm, uint32_t keySize)
+{
+   LoadFile();
+
+   Key key(algorithm, keySize);
+   auto known = s_costs.find(key);
+   if(known != s_costs.end())
+     return known->second;
+
+   Costs costs = Measure(algorithm, keySize);
+   NS_LOG_INFO("Calibrated " << SigningKeyChain::GetAlgorithmName(algorithm) << "/" << keySize
+               << ": sign " << costs.signNs << "ns, verify " << costs.verifyNs << "ns");
+   AppendToFile(key, costs);
+   return s_costs[key] = costs;
+}
+
+CryptoCostModel::Costs
+CryptoCostModel::Measure(SigningKeyChain::Algorithm algorithm, uint32_t keySize)
+{
+   UintegerValue roundsValue;
+   g_cryptoCostRounds.GetValue(roundsValue);
+   uint32_t rounds = roundsValue.Get();
+
+   //an identity of its own per pair, so the calibration key has exactly the asked for size
+   Name identity("/crypto-cost-model");
+   identity.append(SigningKeyChain::GetAlgorithmName(algorithm)).appendNumber(keySize);
+   ::ndn::security::SigningInfo info = SigningKeyChain::Get().Prepare(identity, algorithm, keySize);
+
+   ConstBufferPtr keyBits = SigningKeyChain::Get().GetPublicKeyBits(identity);
+   std::unique_ptr< ::ndn::security::v1::PublicKey> publicKey;
+   if(algorithm != SigningKeyChain::SHA256)
+   {
+     publicKey.reset(new ::ndn::security::v1::PublicKey(keyBits->buf(), keyBits->size()));
+   }
+
+   //a Data shaped like the scenarios' (1024 byte payload)
+   Data data(Name("/crypto-cost-model/data").appendSequenceNumber(1));
+   std::vector<uint8_t> payload(1024, 0);
+   data.setContent(payload.data(), payload.size());
+
+   std::vector<int64_t> signNs, verifyNs;
+   bool good = true;
+   for(uint32_t i = 0; i < rounds; i++)
+   {
+     auto start = std::chrono::steady_clock::now();
+     SigningKeyChain::Get().Sign(data, info);
+     auto signedAt = std::chrono::steady_clock::now();
+     if(algorithm == SigningKeyChain::SHA256)
+     {
+       good = ::ndn::Validator::verifySignature(data, ::ndn::DigestSha256(data.getSignature())) && good;
+     }
+     else
+     {
+       good = ::ndn::Validator::verifySignature(data, *publicKey) && good;
+     }
+     auto verifiedAt = std::chrono::steady_clock::now();
+
+     signNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(signedAt - start).count());
+     verifyNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(verifiedAt - signedAt).count());
+   }
+   if(!good)
+   {
+     NS_LOG_WARN("Calibration signatures for " << identity << " did not verify");
+   }
+
+   //median: the first calls pay for cold caches
+   std::nth_element(signNs.begin(), signNs.begin() + rounds / 2, signNs.end());
+   std::nth_element(verifyNs.begin(), verifyNs.begin() + rounds / 2, verifyNs.end());
+
+   Costs costs;
+   costs.signNs = signNs[rounds / 2];
+   costs.verifyNs = verifyNs[rounds / 2];
+   return costs;
+}
+
+void
+CryptoCostModel::Reset()
+{
+   s_costs.clear();
+   s_fileLoaded = false;
+}
+
+//file format: one "<algorithm> <keySize> <signNs> <verifyNs>" line per pair
+void
+CryptoCostModel::LoadFile()
+{
+   if(s_fileLoaded)
+     return;
+   s_fileLoaded = true;
+
+   StringValue path;
+   g_cryptoCostFile.GetValue(path);
+   if(path.Get().empty())
+     return;
+
+   std::ifstream file(path.Get().c_str());
+   std::string algorithm;
+   uint32_t keySize;
+   Costs costs;
+   while(file >> algorithm >> keySize >> costs.signNs >> costs.verifyNs)
+   {
+     s_costs[Key(SigningKeyChain::ParseAlgorithm(algorithm), keySize)] = costs;
+   }
+   NS_LOG_INFO("Loaded " << s_costs.size() << " calibrations from " << path.Get());
+}
+
+void
+CryptoCostModel::AppendToFile(const Key& key, const Costs& costs)
+{
+   StringValue path;
+   g_cryptoCostFile.GetValue(path);
+   if(path.Get().empty())
+     return;
+
+   std::ofstream file(path.Get().c_str(), std::ios::app);
+   file << SigningKeyChain::GetAlgorithmName(key.first) << " " << key.second << " "
+        << costs.signNs << " " << costs.verifyNs << std::endl;
+   if(!file)
+   {
+     NS_LOG_WARN("Could not write calibration to " << path.Get());
+   }
+}
+
+} // namespace ndn
+} // namespace ns3
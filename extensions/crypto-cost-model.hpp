@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef CRYPTOCOSTMODEL_H
+#define CRYPTOCOSTMODEL_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/nstime.h"
+#include "signing-key-chain.hpp"
+
+#include <map>
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+
+//Simulated processing delay of signing and verifying.
+//
+//The real crypto in SignedProducerApp/VerificationCache costs wall-clock time only, so without this
+//mitigation looks free in simulated time. The cost of an (algorithm, key size) pair is measured once per run
+//by a small microbenchmark on this host (median of CalibrationRounds sign and verify calls with
+//SigningKeyChain), multiplied by --CryptoCostScale (e.g. 4 for a device four times slower than the host).
+//--CryptoCostFile=<path> keeps calibrations in a file: pairs found there are not measured again, new
+//ones are appended, so replications and paired runs all use the same costs.
+//
+//The apps use it through their SimulateCryptoCost attributes; anything else that signs or verifies
+//(e.g. a verifying forwarder) can charge itself the same delays.
+class CryptoCostModel
+{
+  public:
+     struct Costs
+     {
+       int64_t signNs;
+       int64_t verifyNs;
+     };
+
+     //host cost (scaled) of one signature / one verification (keySize 0 = algorithm default)
+     static Time
+     GetSignDelay(SigningKeyChain::Algorithm algorithm, uint32_t keySize);
+
+     static Time
+     GetVerifyDelay(SigningKeyChain::Algorithm algorithm, uint32_t keySize);
+
+     //calibrates a pair now (if not known yet). Scenarios call it before Simulator::Run so the measurement is not
+     //charged to the run's wall clock (profiler, CountingScheduler); the apps' GetSignDelay/GetVerifyDelay in
+     //StartApplication only measure pairs nobody calibrated up front
+     static const Costs&
+     Calibrate(SigningKeyChain::Algorithm algorithm, uint32_t keySize);
+
+     //forgets the calibrations so the next scenario in this process reads its own CryptoCostFile
+     //(ScenarioRegistry reset hook)
+     static void
+     Reset();
+
+  private:
+     typedef std::pair<SigningKeyChain::Algorithm, uint32_t> Key;
+
+     static Costs
+     Measure(SigningKeyChain::Algorithm algorithm, uint32_t keySize);
+
+     static void
+     LoadFile();
+
+     static void
+     AppendToFile(const Key& key, const Costs& costs);
+
+     static std::map<Key, Costs> s_costs;
+     static bool s_fileLoaded;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
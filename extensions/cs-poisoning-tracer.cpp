@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "cs-poisoning-tracer.hpp"
+#include "bad-data-filter.hpp"
+#include "trace-shards.hpp"
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CsPoisoningTracer");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CsPoisoningTracer);
+
+static GlobalValue g_csPoisoningFile("CsPoisoningFile",
+                                     "File for the time series of poisoned content store entries (empty = none)",
+                                     StringValue(""), MakeStringChecker());
+
+static GlobalValue g_csPoisoningInterval("CsPoisoningInterval", "Simulated time between two samples",
+                                         TimeValue(Seconds(1)), MakeTimeChecker(MilliSeconds(1)));
+
+std::FILE* CsPoisoningTracer::s_output = nullptr;
+
+TypeId
+CsPoisoningTracer::GetTypeId()
+{
+   static TypeId tid = TypeId("ns3::ndn::CsPoisoningTracer")
+     .SetGroupName("Ndn")
+     .SetParent<Object>()
+     .AddConstructor<CsPoisoningTracer>();
+   return tid;
+}
+
+CsPoisoningTracer::CsPoisoningTracer()
+  : m_lastEntries(0)
+  , m_lastPoisoned(0)
+{
+}
+
+void
+CsPoisoningTracer::InstallAll()
+{
+   for(NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++)
+   {
+     Get(*node);
+   }
+}
+
+Ptr<CsPoisoningTracer>
+CsPoisoningTracer::Get(Ptr<Node> node)
+{
+   Ptr<CsPoisoningTracer> tracer = node->GetObject<CsPoisoningTracer>();
+   if(tracer == 0)
+   {
+     Ptr<ContentStore> cs = node->GetObject<ContentStore>();
+     if(cs == 0)
+       return 0;
+
+     tracer = CreateObject<CsPoisoningTracer>();
+     tracer->m_node = node;
+     tracer->m_cs = cs;
+     cs->TraceConnectWithoutContext("DidAddEntry", MakeCallback(&CsPoisoningTracer::OnAdd, tracer));
+     node->AggregateObject(tracer);
+
+     //what is cached already (e.g. a warm start from a CsSnapshot) is looked at once here
+     for(Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry))
+     {
+       tracer->OnAdd(entry);
+     }
+   }
+   return tracer;
+}
+
+void
+CsPoisoningTracer::OnAdd(Ptr<const cs::Entry> entry)
+{
+   static const name::Component EVIL_MARKER("evil");
+
+   const Name& name = entry->GetName();
+   bool poisoned = !name.empty() && name.get(-1) == EVIL_MARKER;
+   if(!poisoned)
+   {
+     Ptr<BadDataFilter> filter = m_node->GetObject<BadDataFilter>();
+     poisoned = filter != 0 && filter->Contains(entry->GetData()->getFullName().get(-1));
+   }
+   if(poisoned)
+   {
+     m_poisoned.push_back(entry);
+   }
+}
+
+uint64_t
+CsPoisoningTracer::GetPoisoned()
+{
+   //the store lets go of an entry when it evicts it or it expires, so mine is the last reference
+   m_poisoned.erase(std::remove_if(m_poisoned.begin(), m_poisoned.end(),
+                                   [] (const Ptr<const cs::Entry>& entry) {
+                                     return entry->GetReferenceCount() == 1;
+                                   }),
+                    m_poisoned.end());
+   return m_poisoned.size();
+}
+
+uint64_t
+CsPoisoningTracer::GetEntries() const
+{
+   return m_cs->GetSize();
+}
+
+void
+CsPoisoningTracer::StartOutput()
+{
+   if(s_output != nullptr)
+     return;
+
+   StringValue file;
+   g_csPoisoningFile.GetValue(file);
+   if(file.Get().empty())
+     return;
+
+   std::string path = TraceShards::Resolve(file.Get());
+   s_output = std::fopen(path.c_str(), "w");
+   if(s_output == nullptr)
+   {
+     NS_LOG_ERROR("Cannot open " << path);
+     return;
+   }
+   std::fprintf(s_output, "Time\tNode\tEntries\tPoisoned\n");
+
+   InstallAll();
+   Simulator::ScheduleNow(&CsPoisoningTracer::Sample);
+   Simulator::ScheduleDestroy(&CsPoisoningTracer::StopOutput);
+}
+
+void
+CsPoisoningTracer::Sample()
+{
+   double now = Simulator::Now().GetSeconds();
+   for(NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++)
+   {
+     Ptr<CsPoisoningTracer> tracer = (*node)->GetObject<CsPoisoningTracer>();
+     if(tracer == 0)
+       continue;
+
+     uint64_t entries = tracer->GetEntries();
+     uint64_t poisoned = tracer->GetPoisoned();
+     if(now > 0 && entries == tracer->m_lastEntries && poisoned == tracer->m_lastPoisoned)
+       continue; //unchanged, the previous line still holds
+
+     std::fprintf(s_output, "%g\t%u\t%llu\t%llu\n", now, (*node)->GetId(),
+                  static_cast<unsigned long long>(entries), static_cast<unsigned long long>(poisoned));
+     tracer->m_lastEntries = entries;
+     tracer->m_lastPoisoned = poisoned;
+   }
+
+   TimeValue interval;
+   g_csPoisoningInterval.GetValue(interval);
+   Simulator::Schedule(interval.Get(), &CsPoisoningTracer::Sample);
+}
+
+void
+CsPoisoningTracer::StopOutput()
+{
+   if(s_output != nullptr)
+   {
+     std::fclose(s_output);
+     s_output = nullptr;
+   }
+}
+
+void
+CsPoisoningTracer::DoDispose()
+{
+   m_poisoned.clear();
+   m_cs = 0;
+   m_node = 0;
+   Object::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef CSPOISONINGTRACER_H
+#define CSPOISONINGTRACER_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/object.h"
+#include "ns3/node.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+//How many poisoned entries sit in a node's (old, ns3::ndn::cs::*) content store.
+//
+//An entry is poisoned when its name carries the evil producer's marker component, or its digest is in the
+//node's BadDataFilter when it is cached (entries found bad later are not counted). Nothing scans the store:
+//the tracer keeps a reference to each poisoned entry the store's DidAddEntry trace announces, and an entry
+//only it still references has been evicted or has expired. The count therefore costs the poisoned
+//entries, not the store size (the store is walked once, when the tracer is hooked to it).
+//
+//--CsPoisoningFile=<path> writes the counts of every node as a time series every --CsPoisoningInterval
+//(1s by default): "Time Node Entries Poisoned", one line per node whose counts changed since the previous
+//sample. The MetricsSampler reads the same counters.
+class CsPoisoningTracer : public Object
+{
+  public:
+     static TypeId
+     GetTypeId();
+
+     CsPoisoningTracer();
+
+     //a tracer on every node with an old content store (nodes that have one keep it)
+     static void
+     InstallAll();
+
+     //the node's tracer, created and hooked to its content store the first time someone asks
+     //(0 when the node has no old content store)
+     static Ptr<CsPoisoningTracer>
+     Get(Ptr<Node> node);
+
+     //starts the --CsPoisoningFile time series if one is set and not running yet
+     static void
+     StartOutput();
+
+     //poisoned entries still cached
+     uint64_t
+     GetPoisoned();
+
+     //all entries in the content store
+     uint64_t
+     GetEntries() const;
+
+  protected:
+     virtual void
+     DoDispose();
+
+  private:
+     void
+     OnAdd(Ptr<const cs::Entry> entry);
+
+     static void
+     Sample();
+
+     static void
+     StopOutput();
+
+     Ptr<Node> m_node;
+     Ptr<ContentStore> m_cs;
+     std::vector<Ptr<const cs::Entry>> m_poisoned; //may still hold evicted entries until GetPoisoned
+     uint64_t m_lastEntries; //as last written to the time series
+     uint64_t m_lastPoisoned;
+
+     static std::FILE* s_output;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "cs-snapshot.hpp"
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CsSnapshot");
+
+namespace ns3 {
+namespace ndn {
+
+static GlobalValue g_csSnapshotSave("CsSnapshotSave", "File to save every node's content store to (empty = none)",
+                                    StringValue(""), MakeStringChecker());
+
+static GlobalValue g_csSnapshotTime("CsSnapshotTime", "Simulated time CsSnapshotSave is taken at",
+                                    TimeValue(Seconds(10)), MakeTimeChecker());
+
+static GlobalValue g_csSnapshotLoad("CsSnapshotLoad", "Content store snapshot to load before the run (empty = none)",
+                                    StringValue(""), MakeStringChecker());
+
+static const char CS_SNAPSHOT_MAGIC[8] = {'N', 'D', 'N', 'C', 'S', 'S', 'N', 'P'};
+static const uint32_t CS_SNAPSHOT_VERSION = 1;
+static const size_t DIGEST_SIZE = 32;
+
+//bytes from the read position to the end of the file, so sizes read from it can be checked before allocating
+static uint64_t
+BytesLeft(std::FILE* in, uint64_t fileSize)
+{
+   long position = std::ftell(in);
+   return position < 0 || static_cast<uint64_t>(position) > fileSize ? 0 : fileSize - position;
+}
+
+void
+CsSnapshot::Install()
+{
+   StringValue load;
+   g_csSnapshotLoad.GetValue(load);
+   if(!load.Get().empty())
+   {
+     Load(load.Get());
+   }
+
+   StringValue save;
+   g_csSnapshotSave.GetValue(save);
+   if(!save.Get().empty())
+   {
+     TimeValue time;
+     g_csSnapshotTime.GetValue(time);
+     Simulator::Schedule(time.Get(), &CsSnapshot::Save, save.Get());
+   }
+}
+
+void
+CsSnapshot::Save(const std::string& path)
+{
+   //every distinct Data once (by digest), the nodes refer to it by index
+   std::vector<shared_ptr<const Data>> table;
+   std::map<name::Component, uint32_t> indexes;
+   std::vector<std::pair<uint32_t, std::vector<uint32_t>>> nodes;
+
+   for(NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++)
+   {
+     Ptr<ContentStore> cs = (*node)->GetObject<ContentStore>();
+     if(cs == 0)
+       continue;
+
+     nodes.push_back(std::make_pair((*node)->GetId(), std::vector<uint32_t>()));
+     for(Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry))
+     {
+       shared_ptr<const Data> data = entry->GetData();
+       auto inserted = indexes.insert(std::make_pair(data->getFullName().get(-1), table.size()));
+       if(inserted.second)
+       {
+         table.push_back(data);
+       }
+       nodes.back().second.push_back(inserted.first->second);
+     }
+   }
+
+   std::FILE* out = std::fopen(path.c_str(), "wb");
+   if(out == nullptr)
+   {
+     NS_LOG_ERROR("Cannot write content store snapshot " << path);
+     return;
+   }
+   uint32_t header[3] = {CS_SNAPSHOT_VERSION, static_cast<uint32_t>(table.size()),
+                         static_cast<uint32_t>(nodes.size())};
+   std::fwrite(CS_SNAPSHOT_MAGIC, sizeof(CS_SNAPSHOT_MAGIC), 1, out);
+   std::fwrite(header, sizeof(header), 1, out);
+
+   uint64_t entries = 0;
+   for(const auto& data : table)
+   {
+     const Block& wire = data->wireEncode();
+     uint32_t size = wire.size();
+     std::fwrite(data->getFullName().get(-1).value(), DIGEST_SIZE, 1, out);
+     std::fwrite(&size, sizeof(size), 1, out);
+     std::fwrite(wire.wire(), size, 1, out);
+   }
+   for(const auto& node : nodes)
+   {
+     uint32_t nodeHeader[2] = {node.first, static_cast<uint32_t>(node.second.size())};
+     std::fwrite(nodeHeader, sizeof(nodeHeader), 1, out);
+     std::fwrite(node.second.data(), sizeof(uint32_t), node.second.size(), out);
+     entries += node.second.size();
+   }
+   if(std::fclose(out) != 0)
+   {
+     NS_LOG_ERROR("Cannot write content store snapshot " << path);
+     return;
+   }
+   NS_LOG_INFO("Saved " << entries << " entries (" << table.size() << " distinct Data) of " << nodes.size()
+               << " nodes to " << path << " at " << Simulator::Now().GetSeconds() << "s");
+}
+
+uint64_t
+CsSnapshot::Load(const std::string& path)
+{
+   std::FILE* in = std::fopen(path.c_str(), "rb");
+   if(in == nullptr)
+   {
+     NS_LOG_ERROR("Cannot read content store snapshot " << path);
+     return 0;
+   }
+
+   char magic[sizeof(CS_SNAPSHOT_MAGIC)];
+   uint32_t header[3];
+   if(std::fread(magic, sizeof(magic), 1, in) != 1 || std::memcmp(magic, CS_SNAPSHOT_MAGIC, sizeof(magic)) != 0
+      || std::fread(header, sizeof(header), 1, in) != 1 || header[0] != CS_SNAPSHOT_VERSION)
+   {
+     NS_LOG_ERROR(path << " is not a content store snapshot");
+     std::fclose(in);
+     return 0;
+   }
+
+   uint64_t fileSize = 0;
+   long start = std::ftell(in);
+   if(start >= 0 && std::fseek(in, 0, SEEK_END) == 0)
+   {
+     long end = std::ftell(in);
+     fileSize = end < 0 ? 0 : end;
+     std::fseek(in, start, SEEK_SET);
+   }
+
+   //every count and size below comes from the file, so none is trusted beyond the bytes actually left in it
+   std::vector<shared_ptr<const Data>> table;
+   table.reserve(std::min<uint64_t>(header[1], BytesLeft(in, fileSize) / (DIGEST_SIZE + sizeof(uint32_t))));
+   for(uint32_t i = 0; i < header[1]; i++)
+   {
+     uint8_t digest[DIGEST_SIZE];
+     uint32_t size;
+     if(std::fread(digest, DIGEST_SIZE, 1, in) != 1 || std::fread(&size, sizeof(size), 1, in) != 1
+        || size == 0 || size > BytesLeft(in, fileSize))
+       break;
+     auto wire = make_shared<Buffer>(size);
+     if(std::fread(wire->data(), size, 1, in) != 1)
+       break;
+
+     shared_ptr<Data> data;
+     try
+     {
+       data = make_shared<Data>(Block(wire));
+     }
+     catch(const ::ndn::tlv::Error& e)
+     {
+       NS_LOG_ERROR("Data " << i << " in " << path << " does not decode: " << e.what());
+       break;
+     }
+     if(std::memcmp(data->getFullName().get(-1).value(), digest, DIGEST_SIZE) != 0)
+     {
+       NS_LOG_WARN("Digest mismatch for " << data->getName() << " in " << path);
+     }
+     table.push_back(data);
+   }
+   if(table.size() != header[1])
+   {
+     NS_LOG_ERROR(path << " is not a valid content store snapshot (cut off or corrupt in its Data)");
+     std::fclose(in);
+     return 0;
+   }
+
+   //read and check every node section first: a corrupt file loads nothing rather than half a warm start
+   std::vector<std::pair<uint32_t, std::vector<uint32_t>>> nodes;
+   bool valid = true;
+   for(uint32_t n = 0; n < header[2] && valid; n++)
+   {
+     uint32_t nodeHeader[2];
+     if(std::fread(nodeHeader, sizeof(nodeHeader), 1, in) != 1
+        || nodeHeader[1] > BytesLeft(in, fileSize) / sizeof(uint32_t))
+     {
+       valid = false;
+       break;
+     }
+     std::vector<uint32_t> entries(nodeHeader[1]);
+     valid = std::fread(entries.data(), sizeof(uint32_t), entries.size(), in) == entries.size()
+       && std::all_of(entries.begin(), entries.end(), [&table] (uint32_t index) { return index < table.size(); });
+     nodes.push_back(std::make_pair(nodeHeader[0], std::move(entries)));
+   }
+   std::fclose(in);
+   if(!valid)
+   {
+     NS_LOG_ERROR(path << " is not a valid content store snapshot (cut off or corrupt in its node entries)");
+     return 0;
+   }
+
+   uint64_t loaded = 0;
+   for(const auto& entries : nodes)
+   {
+     Ptr<Node> node = entries.first < NodeList::GetNNodes() ? NodeList::GetNode(entries.first) : 0;
+     Ptr<ContentStore> cs = node != 0 ? node->GetObject<ContentStore>() : 0;
+     if(cs == 0)
+     {
+       NS_LOG_WARN("No content store on node " << entries.first << ", skipping its " << entries.second.size()
+                   << " entries");
+       continue;
+     }
+     for(uint32_t index : entries.second)
+     {
+       if(cs->Add(table[index]))
+       {
+         loaded++;
+       }
+     }
+   }
+
+   NS_LOG_INFO("Loaded " << loaded << " entries (" << table.size() << " distinct Data) from " << path);
+   return loaded;
+}
+
+} // namespace ndn
+} // namespace ns3
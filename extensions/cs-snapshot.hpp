@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef CSSNAPSHOT_H
+#define CSSNAPSHOT_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/nstime.h"
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+//Warm start: the content stores (ns3::ndn::cs::*) of every node saved at some point of one run and put
+//back into the nodes of another before it starts, so sweep points that share a warm state skip filling
+//the caches.
+//
+//--CsSnapshotSave=<path> --CsSnapshotTime=<t> saves at simulated time t; --CsSnapshotLoad=<path> loads
+//(both in one run is fine). Scenarios call Install() once their nodes are set up, before Simulator::Run.
+//
+//File (native byte order): 8 byte magic, uint32 version, Data count, node count; every distinct Data once
+//(its 32 byte implicit digest, wire size and wire encoding: name, freshness, content and signature);
+//then per node its id, entry count and one uint32 index into the Data per entry. A Data cached on many
+//nodes is stored once. Loaded entries start their freshness over, and the stores' replacement order is
+//the order the entries are listed in, not their recency in the saved run.
+class CsSnapshot
+{
+  public:
+     //acts on the CsSnapshot* global values: loads now and/or schedules the save
+     static void
+     Install();
+
+     static void
+     Save(const std::string& path);
+
+     //returns the number of entries loaded (into nodes with the same id and a content store)
+     static uint64_t
+     Load(const std::string& path);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
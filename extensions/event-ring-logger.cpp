@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "event-ring-logger.hpp"
+#include "trace-shards.hpp"
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE("ndn.EventRingLogger");
+
+namespace ns3 {
+namespace ndn {
+
+static GlobalValue g_eventLogFile("EventLogFile",
+                                  "Binary file the apps' event rings are drained to (empty = no event log)",
+                                  StringValue(""), MakeStringChecker());
+
+static GlobalValue g_eventLogRingSize("EventLogRingSize",
+                                      "Records each app buffers before draining them to the event log",
+                                      UintegerValue(4096), MakeUintegerChecker<uint32_t>(1));
+
+//file header: 8 byte magic, then version and record size as uint32
+static const char EVENT_LOG_MAGIC[8] = {'N', 'D', 'N', 'E', 'V', 'L', 'O', 'G'};
+static const uint32_t EVENT_LOG_VERSION = 1;
+
+//the one file every ring in the process drains into (closed when the last ring goes away)
+static FILE* g_sink = nullptr;
+static uint32_t g_sinkUsers = 0;
+
+#ifdef NDN_EVENT_LOG_ENABLE
+static bool
+AcquireSink()
+{
+   if(g_sink == nullptr)
+   {
+     StringValue file;
+     g_eventLogFile.GetValue(file);
+     if(file.Get().empty())
+       return false;
+
+     std::string path = TraceShards::Resolve(file.Get());
+     g_sink = std::fopen(path.c_str(), "wb");
+     if(g_sink == nullptr)
+     {
+       NS_LOG_ERROR("Cannot open event log " << path);
+       return false;
+     }
+
+     uint32_t header[2] = {EVENT_LOG_VERSION, sizeof(EventRecord)};
+     std::fwrite(EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC), 1, g_sink);
+     std::fwrite(header, sizeof(header), 1, g_sink);
+   }
+   g_sinkUsers++;
+   return true;
+}
+#endif
+
+static void
+ReleaseSink()
+{
+   if(--g_sinkUsers == 0)
+   {
+     std::fclose(g_sink);
+     g_sink = nullptr;
+   }
+}
+
+EventRing::EventRing()
+  : m_next(0)
+  , m_node(0)
+  , m_app(0)
+{
+}
+
+EventRing::~EventRing()
+{
+   if(!m_records.empty())
+   {
+     Flush();
+     ReleaseSink();
+   }
+}
+
+void
+EventRing::Open(uint32_t node, uint32_t app)
+{
+   //compiled out (no NDN_EVENT_LOG_ENABLE): the ring stays empty so nothing is ever recorded
+#ifdef NDN_EVENT_LOG_ENABLE
+   if(!m_records.empty() || !AcquireSink())
+     return;
+
+   UintegerValue size;
+   g_eventLogRingSize.GetValue(size);
+
+   m_node = node;
+   m_app = app;
+   m_next = 0;
+   m_records.resize(size.Get());
+#else
+   (void)node;
+   (void)app;
+#endif
+}
+
+void
+EventRing::Flush()
+{
+   if(m_next == 0)
+     return;
+
+   std::fwrite(m_records.data(), sizeof(EventRecord), m_next, g_sink);
+   m_next = 0;
+}
+
+} // namespace ndn
+} // namespace ns3
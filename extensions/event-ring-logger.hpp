@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef EVENTRINGLOGGER_H
+#define EVENTRINGLOGGER_H
+
+#include "ns3/simulator.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+//Per-packet diagnostics for the apps without stream formatting:
+//  each app owns an EventRing of fixed-size records, preallocated when the app starts, which is drained
+//  in batches to one binary file shared by every app in the process (decode it with tools/event-log-dump.py)
+//
+//Runtime switch: --EventLogFile=<path> (off when empty), ring size with --EventLogRingSize=<records>
+//Compile-time switch: ./waf configure --disable-event-log removes every NDN_EVENT_LOG call
+#ifdef NDN_EVENT_LOG_ENABLE
+#define NDN_EVENT_LOG(ring, type, seq, flags, arg) (ring).Record((type), (seq), (flags), (arg))
+#else
+//the arguments are still named (never evaluated) so values computed only for the log do not warn as unused
+#define NDN_EVENT_LOG(ring, type, seq, flags, arg) \
+  do { if (false) { (void)(ring); (void)(type); (void)(seq); (void)(flags); (void)(arg); } } while (false)
+#endif
+
+namespace ns3 {
+namespace ndn {
+
+//what happened (keep tools/event-log-dump.py in sync)
+enum EventType : uint16_t
+{
+  EVENT_INTEREST_SENT = 1,     //seq, arg = nonce
+  EVENT_PURSUIT_SENT = 2,      //seq, arg = nonce (Interest with Exclude for the evil data)
+  EVENT_KEY_INTEREST_SENT = 3, //seq = key request seq, arg = nonce
+  EVENT_DATA_RECEIVED = 4,     //seq, flags = hop count, arg = payload size
+  EVENT_EVIL_DATA = 5,         //seq, arg = payload size (failed the good data check)
+  EVENT_KEY_RECEIVED = 6,      //seq = data seq being verified, flags = hop count
+  EVENT_PURSUIT_STARTED = 7,   //seq = data seq being pursued
+  EVENT_NACK_RECEIVED = 8,     //seq, arg = nack reason
+  EVENT_EVIL_DATA_SENT = 9,    //seq, arg = payload size
+  EVENT_SIGNATURE_CHECKED = 10, //seq = data seq, flags = 1 if the signature is good
+  EVENT_KNOWN_BAD_DROPPED = 11, //seq, arg = payload size (digest found in the node's BadDataFilter)
+  EVENT_NOTICE_SENT = 12,      //seq = data seq found bad
+  EVENT_NOTICE_RECEIVED = 13,  //seq = data seq another consumer found bad
+  EVENT_PREFILTER_TRUSTED = 14, //seq, arg = anomaly score * 1000 (accepted without verification)
+  EVENT_ROLLBACK = 15,         //seq, arg = microseconds the bad Data was in use (Speculative)
+};
+
+//one 32 byte record on disk (native byte order)
+struct EventRecord
+{
+  int64_t time; //simulated time in ns
+  uint32_t node;
+  uint32_t app;
+  uint32_t seq;
+  uint16_t type;
+  uint16_t flags;
+  uint64_t arg;
+};
+
+class EventRing
+{
+  public:
+     EventRing();
+
+     ~EventRing();
+
+     //allocates the ring if --EventLogFile is set (else every Record is a no-op)
+     void
+     Open(uint32_t node, uint32_t app);
+
+     //writes whatever is still buffered
+     void
+     Flush();
+
+     void
+     Record(uint16_t type, uint32_t seq, uint16_t flags, uint64_t arg);
+
+  private:
+     std::vector<EventRecord> m_records; //empty while logging is off
+     size_t m_next; //next free slot
+     uint32_t m_node;
+     uint32_t m_app;
+};
+
+inline void
+EventRing::Record(uint16_t type, uint32_t seq, uint16_t flags, uint64_t arg)
+{
+   if(m_records.empty())
+     return;
+
+   EventRecord& record = m_records[m_next];
+   record.time = Simulator::Now().GetNanoSeconds();
+   record.node = m_node;
+   record.app = m_app;
+   record.seq = seq;
+   record.type = type;
+   record.flags = flags;
+   record.arg = arg;
+
+   if(++m_next == m_records.size())
+   {
+     Flush();
+   }
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
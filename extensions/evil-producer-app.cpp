@@ -21,9 +21,12 @@
 
 
 #include "evil-producer-app.hpp"
+#include "handler-profiler.hpp"
+#include "shared-payload.hpp"
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/double.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp" //it's an L...
@@ -57,19 +60,33 @@ EvilProducerApp::GetTypeId(void)
                   MakeUintegerAccessor(&EvilProducerApp::m_signature), 
                   MakeUintegerChecker<uint32_t>())
     .AddAttribute("KeyLocator", "Name for the Key Locator", NameValue(), 
-                  MakeNameAccessor(&EvilProducerApp::m_keyLocator), MakeNameChecker());
+                  MakeNameAccessor(&EvilProducerApp::m_keyLocator), MakeNameChecker())
+    .AddAttribute("AnswerProbability", "Probability of answering an interest (1 = always answer)",
+                  DoubleValue(1.0), MakeDoubleAccessor(&EvilProducerApp::m_answerProbability),
+                  MakeDoubleChecker<double>(0.0, 1.0));
 
    return typeId;
 }
 
 EvilProducerApp::EvilProducerApp()
+  : m_answerProbability(1.0)
+  , m_rand(CreateObject<UniformRandomVariable>())
 {
    NS_LOG_FUNCTION_NOARGS();
 }
 
+int64_t
+EvilProducerApp::AssignStreams(int64_t stream)
+{
+   m_rand->SetStream(stream);
+   return 1;
+}
+
 void
 EvilProducerApp::OnInterest(shared_ptr<const Interest> interest)
 {
+  HandlerProfiler::Scope profile(HandlerProfiler::EVIL_ON_INTEREST);
+
   //log that I received the interest
   App::OnInterest(interest);
   NS_LOG_FUNCTION(this << interest);
@@ -78,6 +95,10 @@ EvilProducerApp::OnInterest(shared_ptr<const Interest> interest)
   if(!m_active)
     return;
 
+  //only draw when answering is not certain so default runs keep their old behaviour
+  if(m_answerProbability < 1.0 && m_rand->GetValue(0.0, 1.0) >= m_answerProbability)
+    return;
+
    //do data creation
    Name dataName(interest->getName());
    //no need for "/" because append already adds the slash...
@@ -86,7 +107,7 @@ EvilProducerApp::OnInterest(shared_ptr<const Interest> interest)
    auto data = make_shared<Data>();
    data->setName(dataName);
    data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-   data->setContent(make_shared<::ndn::Buffer>(m_payloadSize));
+   data->setContent(SharedPayload::Get(m_payloadSize)); //one zeroed block shared by all my replies
    Signature sig;
    SignatureInfo sigInfo(static_cast<::ndn::tlv::SignatureTypeValue>(255));
 
@@ -99,13 +120,18 @@ EvilProducerApp::OnInterest(shared_ptr<const Interest> interest)
    data->setSignature(sig);
   
   //log that I am sending the data
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data:" << data->getName());
+  NDN_EVENT_LOG(m_eventLog, EVENT_EVIL_DATA_SENT,
+                interest->getName().get(-1).isSequenceNumber() ? interest->getName().get(-1).toSequenceNumber() : 0,
+                0, m_payloadSize);
 
   data->wireEncode(); 
 
   //transmit the data
   m_transmittedDatas(data, this, m_face);
-  m_appLink->onReceiveData(*data);
+  {
+    HandlerProfiler::Scope forwarding(HandlerProfiler::APP_FACE);
+    m_appLink->onReceiveData(*data);
+  }
 }
 
 //inherited from application (overriding them to do more than just app stuff)
@@ -116,12 +142,14 @@ EvilProducerApp::StartApplication()
    NS_LOG_FUNCTION_NOARGS();
    App::StartApplication();
    FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+   m_eventLog.Open(GetNode()->GetId(), GetId());
 }
 
 void
 EvilProducerApp::StopApplication()
 {
     NS_LOG_FUNCTION_NOARGS();
+    m_eventLog.Flush();
     App::StopApplication();
 }
 
@@ -27,6 +27,8 @@
 #include "ns3/integer.h"
 #include "ns3/string.h"
 #include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "event-ring-logger.hpp"
 
 #include <ndn-cxx/security/key-chain.hpp> //for later use...
 
@@ -50,6 +52,11 @@ class EvilProducerApp : public App
      virtual void
      OnInterest(shared_ptr<const Interest> interest);
 
+     //pins the attacker's answer decisions to a fixed RNG substream (so paired runs share them)
+     //returns the number of streams used
+     int64_t
+     AssignStreams(int64_t stream);
+
    protected:
      //inherited from application (overriding them to do more than just app stuff)
      virtual void
@@ -65,6 +72,10 @@ class EvilProducerApp : public App
      Name m_keyLocator;
      uint32_t m_signature;
      uint32_t m_payloadSize;
+     double m_answerProbability; //chance that I answer a given interest at all
+     Ptr<UniformRandomVariable> m_rand; //generator for the answer decisions
+
+     EventRing m_eventLog; //per-packet diagnostics (see event-ring-logger.hpp)
 
      //from ndn_app, I auto get: m_face, m_active, and logging details of traced callback
 };
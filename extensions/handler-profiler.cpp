@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "handler-profiler.hpp"
+
+#include <iomanip>
+
+namespace ns3 {
+namespace ndn {
+
+bool HandlerProfiler::s_enabled = false;
+int64_t HandlerProfiler::s_childNs = 0;
+int64_t HandlerProfiler::s_selfNs[HandlerProfiler::SLOT_COUNT] = {};
+uint64_t HandlerProfiler::s_calls[HandlerProfiler::SLOT_COUNT] = {};
+
+static const char* const SLOT_NAMES[HandlerProfiler::SLOT_COUNT] = {
+  "SecurityToyClientApp::SendPacket",
+  "SecurityToyClientApp::OnData",
+  "SecurityToyClientApp::OnNack",
+  "SecurityToyClientApp::ScheduleNextPacket",
+  "EvilProducerApp::OnInterest",
+  "NFD forwarding + CS (app faces only)",
+  "scheduler (insert/remove)",
+  "signature verification",
+  "PoisonAwareStrategy (per Interest/Data)",
+};
+
+void
+HandlerProfiler::Enable()
+{
+   s_enabled = true;
+}
+
+int64_t
+HandlerProfiler::GetSelfNs(Slot slot)
+{
+   return s_selfNs[slot];
+}
+
+uint64_t
+HandlerProfiler::GetCalls(Slot slot)
+{
+   return s_calls[slot];
+}
+
+const char*
+HandlerProfiler::GetName(Slot slot)
+{
+   return SLOT_NAMES[slot];
+}
+
+void
+HandlerProfiler::Report(std::ostream& os, double runWallSeconds)
+{
+   double covered = 0;
+
+   os << std::left << std::setw(44) << "Where the wall-clock time went" << std::right
+      << std::setw(12) << "calls" << std::setw(12) << "self s" << std::setw(10) << "% run"
+      << std::setw(12) << "ns/call" << std::endl;
+
+   for(int i = 0; i < SLOT_COUNT; i++)
+   {
+     double self = s_selfNs[i] / 1e9;
+     covered += self;
+     os << std::left << std::setw(44) << SLOT_NAMES[i] << std::right << std::fixed
+        << std::setw(12) << s_calls[i]
+        << std::setw(12) << std::setprecision(4) << self
+        << std::setw(10) << std::setprecision(1) << (runWallSeconds > 0 ? 100 * self / runWallSeconds : 0)
+        << std::setw(12) << std::setprecision(0) << (s_calls[i] > 0 ? s_selfNs[i] / double(s_calls[i]) : 0)
+        << std::endl;
+   }
+
+   //links, queues, routing, tracers, stock producers, router-side forwarding and CS lookups, and anything
+   //else nobody instrumented
+   double rest = runWallSeconds > covered ? runWallSeconds - covered : 0;
+   os << std::left << std::setw(44) << "rest (links, routers, tracers, other apps)" << std::right
+      << std::setw(12) << "-" << std::setw(12) << std::setprecision(4) << rest
+      << std::setw(10) << std::setprecision(1) << (runWallSeconds > 0 ? 100 * rest / runWallSeconds : 0)
+      << std::setw(12) << "-" << std::endl;
+   os.unsetf(std::ios::floatfield);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef HANDLERPROFILER_H
+#define HANDLERPROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+//Opt-in wall-clock profiler for the app handlers (and what they call into).
+//
+//Each instrumented piece of code opens a Scope on its slot. Times are kept exclusive: time spent in a
+//nested scope (e.g. the forwarder called from SendPacket, or the scheduler called from
+//ScheduleNextPacket) is charged to the nested slot only, so the slots add up to the time they cover.
+//While disabled a Scope costs one branch. Enabled by CountingScheduler's Profile attribute.
+//
+//Forwarding and CS lookups are only seen where an app call runs them synchronously (APP_FACE). Routers
+//processing packets that arrive over NetDevice faces run inside ndnSIM/NFD, which has no hook to open a
+//Scope from, so that time lands in the report's "rest" (apart from POISON_AWARE_STRATEGY's triggers).
+class HandlerProfiler
+{
+  public:
+     enum Slot
+     {
+       CLIENT_SEND_PACKET,
+       CLIENT_ON_DATA,
+       CLIENT_ON_NACK,
+       CLIENT_SCHEDULE_NEXT_PACKET,
+       EVIL_ON_INTEREST,
+       APP_FACE, //forwarding (incl. CS lookups) done synchronously when an app hands a packet to its face
+                 //(router-side processing of packets from NetDevice faces is not covered, see above)
+       SCHEDULER, //inserting/removing events in the event queue
+       SIGNATURE_VERIFY, //real signature checks (VerificationCache misses), taken out of the handler's time
+       POISON_AWARE_STRATEGY, //PoisonAwareStrategy's Interest and Data triggers (the forwarding cost it adds)
+       SLOT_COUNT
+     };
+
+     class Scope
+     {
+       public:
+          explicit
+          Scope(Slot slot);
+
+          ~Scope();
+
+       private:
+          Slot m_slot;
+          bool m_active;
+          int64_t m_start;
+          int64_t m_outerChildNs; //child time of the enclosing scope, put back on exit
+     };
+
+     static void
+     Enable();
+
+     static bool
+     IsEnabled();
+
+     //exclusive time spent in a slot and the number of times it was entered
+     static int64_t
+     GetSelfNs(Slot slot);
+
+     static uint64_t
+     GetCalls(Slot slot);
+
+     static const char*
+     GetName(Slot slot);
+
+     //prints the breakdown of runWallSeconds over the slots (the remainder is everything not instrumented)
+     static void
+     Report(std::ostream& os, double runWallSeconds);
+
+  private:
+     static int64_t
+     Now();
+
+     static bool s_enabled;
+     static int64_t s_childNs; //time spent in scopes nested in the current one
+     static int64_t s_selfNs[SLOT_COUNT];
+     static uint64_t s_calls[SLOT_COUNT];
+};
+
+inline
+HandlerProfiler::Scope::Scope(Slot slot)
+  : m_slot(slot)
+  , m_active(s_enabled)
+{
+   if(m_active)
+   {
+     m_outerChildNs = s_childNs;
+     s_childNs = 0;
+     m_start = Now();
+   }
+}
+
+inline
+HandlerProfiler::Scope::~Scope()
+{
+   if(m_active)
+   {
+     int64_t elapsed = Now() - m_start;
+     s_selfNs[m_slot] += elapsed - s_childNs;
+     s_calls[m_slot]++;
+     s_childNs = m_outerChildNs + elapsed;
+   }
+}
+
+inline bool
+HandlerProfiler::IsEnabled()
+{
+   return s_enabled;
+}
+
+inline int64_t
+HandlerProfiler::Now()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
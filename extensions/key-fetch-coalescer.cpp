@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "key-fetch-coalescer.hpp"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.KeyFetchCoalescer");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(KeyFetchCoalescer);
+
+TypeId
+KeyFetchCoalescer::GetTypeId()
+{
+   static TypeId tid = TypeId("ns3::ndn::KeyFetchCoalescer")
+     .SetGroupName("Ndn")
+     .SetParent<Object>()
+     .AddConstructor<KeyFetchCoalescer>()
+     .AddAttribute("KeyLifetime", "How long a fetched key is used for verifying without a new key Interest",
+                   TimeValue(Seconds(10)), MakeTimeAccessor(&KeyFetchCoalescer::m_keyLifetime),
+                   MakeTimeChecker())
+     .AddAttribute("FetchTimeout", "After this long without the key, the next consumer asking fetches it again",
+                   TimeValue(Seconds(1)), MakeTimeAccessor(&KeyFetchCoalescer::m_fetchTimeout),
+                   MakeTimeChecker())
+     .AddAttribute("ReportStats", "Print key Interests per verified Data and the verification latency at the end",
+                   BooleanValue(false), MakeBooleanAccessor(&KeyFetchCoalescer::m_reportStats),
+                   MakeBooleanChecker());
+   return tid;
+}
+
+KeyFetchCoalescer::KeyState::KeyState()
+  : fetching(false)
+{
+}
+
+KeyFetchCoalescer::KeyFetchCoalescer()
+  : m_reportStats(false)
+  , m_nodeId(0)
+  , m_keyInterests(0)
+  , m_verified(0)
+  , m_batches(0)
+  , m_cachedKeyVerdicts(0)
+{
+}
+
+Ptr<KeyFetchCoalescer>
+KeyFetchCoalescer::Get(Ptr<Node> node)
+{
+   Ptr<KeyFetchCoalescer> coalescer = node->GetObject<KeyFetchCoalescer>();
+   if(coalescer == 0)
+   {
+     coalescer = CreateObject<KeyFetchCoalescer>();
+     coalescer->m_verificationCache = VerificationCache::Get(node);
+     coalescer->m_nodeId = node->GetId();
+     node->AggregateObject(coalescer);
+   }
+   return coalescer;
+}
+
+bool
+KeyFetchCoalescer::IsCached(const KeyState& state) const
+{
+   return state.content.hasWire() && state.expires > Simulator::Now();
+}
+
+void
+KeyFetchCoalescer::Wait(const Name& keyName, shared_ptr<const Data> data, bool expectDigest, Verdict verdict)
+{
+   KeyState& state = m_keys[keyName];
+
+   Waiter waiter;
+   waiter.data = data;
+   waiter.expectDigest = expectDigest;
+   waiter.verdict = verdict;
+   waiter.since = Simulator::Now();
+
+   if(IsCached(state))
+   {
+     //not from inside the caller's OnData: it is still setting itself up for verification
+     m_cachedKeyVerdicts++;
+     Simulator::ScheduleNow(&KeyFetchCoalescer::Deliver, this, waiter, keyName, state.content);
+     return;
+   }
+
+   state.waiters.push_back(waiter);
+}
+
+void
+KeyFetchCoalescer::Cancel(const Name& keyName, shared_ptr<const Data> data)
+{
+   auto key = m_keys.find(keyName);
+   if(key == m_keys.end())
+     return;
+
+   std::vector<Waiter>& waiters = key->second.waiters;
+   waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                [&data] (const Waiter& waiter) { return waiter.data == data; }),
+                 waiters.end());
+}
+
+bool
+KeyFetchCoalescer::ClaimFetch(const Name& keyName)
+{
+   KeyState& state = m_keys[keyName];
+
+   if(IsCached(state))
+     return false;
+
+   if(state.fetching && Simulator::Now() - state.fetchStarted < m_fetchTimeout)
+     return false;
+
+   state.fetching = true;
+   state.fetchStarted = Simulator::Now();
+   m_keyInterests++;
+   return true;
+}
+
+void
+KeyFetchCoalescer::OnKeyData(const Name& keyName, const Data& keyData)
+{
+   KeyState& state = m_keys[keyName];
+   state.content = keyData.getContent();
+   state.expires = Simulator::Now() + m_keyLifetime;
+   state.fetching = false;
+
+   if(state.waiters.empty())
+     return;
+
+   //the verdicts may send new Data my way, so work on my own copy of the batch
+   std::vector<Waiter> batch;
+   batch.swap(state.waiters);
+   m_batches++;
+   NS_LOG_DEBUG("node(" << m_nodeId << ") verifying " << batch.size() << " Data under " << keyName);
+
+   for(const Waiter& waiter : batch)
+   {
+     Deliver(waiter, keyName, state.content);
+   }
+}
+
+void
+KeyFetchCoalescer::Deliver(const Waiter& waiter, const Name& keyName, const Block& keyContent)
+{
+   bool cached = false;
+   bool good = m_verificationCache->Verify(*waiter.data, keyContent, keyName, waiter.expectDigest, &cached);
+
+   m_verified++;
+   m_totalLatency += Simulator::Now() - waiter.since;
+   waiter.verdict(waiter.data, good, cached);
+}
+
+void
+KeyFetchCoalescer::DoDispose()
+{
+   if(m_reportStats && m_verified > 0)
+   {
+     std::cout << "KeyFetchCoalescer node(" << m_nodeId << "): verified=" << m_verified
+               << " key-interests=" << m_keyInterests
+               << " key-interests-per-verified=" << double(m_keyInterests) / m_verified
+               << " batches=" << m_batches << " cached-key-verdicts=" << m_cachedKeyVerdicts
+               << " mean-wait-ms=" << m_totalLatency.GetMilliSeconds() / double(m_verified) << std::endl;
+   }
+   m_keys.clear();
+   m_verificationCache = 0;
+   Object::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
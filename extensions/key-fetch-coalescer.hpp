@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef KEYFETCHCOALESCER_H
+#define KEYFETCHCOALESCER_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/object.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "verification-cache.hpp"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+//Per-node key fetch coalescing for the verifying consumers.
+//
+//In stop-and-wait every Data pays for its own key Interest round trip. Here a consumer with a Data to verify
+//parks it with Wait() under the key name, and only asks for the key itself if ClaimFetch() says nobody on the
+//node already has a key Interest for that name out (or the one out is older than FetchTimeout). When the key
+//comes in (OnKeyData) all Data parked under it are verified as one batch against the key, which is parsed once,
+//and every waiter gets its verdict. The key is then kept for KeyLifetime, and Data arriving in that window is
+//verified straight away without any key Interest.
+class KeyFetchCoalescer : public Object
+{
+  public:
+     //verdict(data, good, cached): data = the Data parked with Wait(), so a waiter that moved on can tell
+     //a late verdict from the one it is waiting for; cached = the verification cache already knew the answer
+     typedef Callback<void, shared_ptr<const Data>, bool, bool> Verdict;
+
+     static TypeId
+     GetTypeId();
+
+     KeyFetchCoalescer();
+
+     //the node's coalescer, created and aggregated the first time someone asks
+     static Ptr<KeyFetchCoalescer>
+     Get(Ptr<Node> node);
+
+     //parks data until the key under keyName is in (its verdict is delivered from the event loop right away
+     //when the key is already cached)
+     void
+     //(expectDigest: see VerificationCache::Verify)
+     Wait(const Name& keyName, shared_ptr<const Data> data, bool expectDigest, Verdict verdict);
+
+     //takes data back out of the batch waiting for keyName (the waiter gave up on it); a verdict already
+     //scheduled for a cached key still arrives and is the waiter's to ignore
+     void
+     Cancel(const Name& keyName, shared_ptr<const Data> data);
+
+     //true if the caller should send the key Interest now (and is then counted as the one fetching it)
+     bool
+     ClaimFetch(const Name& keyName);
+
+     //a key Data arrived at one of the node's consumers: cache it and verify everything waiting for it
+     void
+     OnKeyData(const Name& keyName, const Data& keyData);
+
+  protected:
+     virtual void
+     DoDispose();
+
+  private:
+     struct Waiter
+     {
+       shared_ptr<const Data> data;
+       bool expectDigest;
+       Verdict verdict;
+       Time since;
+     };
+
+     struct KeyState
+     {
+       KeyState();
+
+       Block content; //key Data content, valid while expires > now
+       Time expires;
+       bool fetching;
+       Time fetchStarted;
+       std::vector<Waiter> waiters;
+     };
+
+     bool
+     IsCached(const KeyState& state) const;
+
+     void
+     Deliver(const Waiter& waiter, const Name& keyName, const Block& keyContent);
+
+  private:
+     std::map<Name, KeyState> m_keys;
+     Time m_keyLifetime;
+     Time m_fetchTimeout;
+     bool m_reportStats;
+     Ptr<VerificationCache> m_verificationCache; //the node's, shared with its consumers
+     uint32_t m_nodeId;
+
+     uint64_t m_keyInterests; //fetches handed out by ClaimFetch
+     uint64_t m_verified; //verdicts delivered
+     uint64_t m_batches; //key arrivals that had Data waiting
+     uint64_t m_cachedKeyVerdicts; //verdicts that needed no key Interest at all
+     Time m_totalLatency; //Wait() to verdict, summed over the verdicts
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "metrics-sampler.hpp"
+#include "cs-poisoning-tracer.hpp"
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MetricsSampler");
+
+namespace ns3 {
+namespace ndn {
+
+static GlobalValue g_metricsFile("MetricsFile",
+                                 "File rewritten with an OpenMetrics snapshot every MetricsInterval (empty = off)",
+                                 StringValue(""), MakeStringChecker());
+
+static GlobalValue g_metricsInterval("MetricsInterval", "Simulated time between two metrics snapshots",
+                                     TimeValue(Seconds(1)), MakeTimeChecker(MilliSeconds(1)));
+
+//metric family, help, in AppCounter order
+static const char* const APP_METRICS[MetricsSampler::APP_COUNTERS][2] = {
+  {"ndn_app_interests_sent", "Interests sent (data, pursuit and key)"},
+  {"ndn_app_data_received", "Data received"},
+  {"ndn_app_evil_received", "Data found bad"},
+  {"ndn_app_key_fetches", "Key Interests sent"},
+  {"ndn_app_pursuits", "Pursuits of the good Data after bad Data"},
+  {"ndn_app_nacks", "Nacks received"},
+};
+
+std::vector<uint64_t> MetricsSampler::s_appCounters;
+std::vector<uint32_t> MetricsSampler::s_appNodes;
+std::vector<uint32_t> MetricsSampler::s_appIds;
+std::string MetricsSampler::s_file;
+bool MetricsSampler::s_started = false;
+
+int32_t
+MetricsSampler::RegisterApp(uint32_t node, uint32_t app)
+{
+   if(!s_started)
+   {
+     StringValue file;
+     g_metricsFile.GetValue(file);
+     if(file.Get().empty())
+       return -1;
+
+     s_file = file.Get();
+     s_started = true;
+     CsPoisoningTracer::InstallAll();
+     Sample();
+     Simulator::ScheduleDestroy(&MetricsSampler::Finish);
+   }
+
+   s_appNodes.push_back(node);
+   s_appIds.push_back(app);
+   s_appCounters.resize(s_appCounters.size() + APP_COUNTERS, 0);
+   return s_appNodes.size() - 1;
+}
+
+void
+MetricsSampler::Sample()
+{
+   WriteSnapshot();
+
+   TimeValue interval;
+   g_metricsInterval.GetValue(interval);
+   Simulator::Schedule(interval.Get(), &MetricsSampler::Sample);
+}
+
+void
+MetricsSampler::Finish()
+{
+   s_appCounters.clear();
+   s_appNodes.clear();
+   s_appIds.clear();
+   s_started = false;
+}
+
+void
+MetricsSampler::WriteSnapshot()
+{
+   //written next to the file and renamed over it, so readers never see half a snapshot
+   std::string partial = s_file + ".partial";
+   std::ofstream out(partial.c_str());
+   if(!out)
+   {
+     NS_LOG_ERROR("Cannot write metrics snapshot " << partial);
+     return;
+   }
+
+   out << "# TYPE ndn_simulation_time_seconds gauge\n"
+       << "# HELP ndn_simulation_time_seconds Simulated time of this snapshot\n"
+       << "ndn_simulation_time_seconds " << Simulator::Now().GetSeconds() << "\n";
+
+   for(int c = 0; c < APP_COUNTERS; c++)
+   {
+     out << "# TYPE " << APP_METRICS[c][0] << " counter\n"
+         << "# HELP " << APP_METRICS[c][0] << " " << APP_METRICS[c][1] << "\n";
+     for(size_t slot = 0; slot < s_appNodes.size(); slot++)
+     {
+       out << APP_METRICS[c][0] << "_total{node=\"" << s_appNodes[slot] << "\",app=\"" << s_appIds[slot]
+           << "\"} " << s_appCounters[slot * APP_COUNTERS + c] << "\n";
+     }
+   }
+
+   //content stores, from the nodes' CsPoisoningTracer counters
+   std::ostringstream entries;
+   std::ostringstream poisoned;
+   for(NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++)
+   {
+     Ptr<CsPoisoningTracer> tracer = (*node)->GetObject<CsPoisoningTracer>();
+     if(tracer == 0)
+       continue;
+     entries << "ndn_cs_entries{node=\"" << (*node)->GetId() << "\"} " << tracer->GetEntries() << "\n";
+     poisoned << "ndn_cs_poisoned_entries{node=\"" << (*node)->GetId() << "\"} " << tracer->GetPoisoned()
+              << "\n";
+   }
+   out << "# TYPE ndn_cs_entries gauge\n"
+       << "# HELP ndn_cs_entries Entries in the node's content store\n"
+       << entries.str()
+       << "# TYPE ndn_cs_poisoned_entries gauge\n"
+       << "# HELP ndn_cs_poisoned_entries Poisoned content store entries (see CsPoisoningTracer)\n"
+       << poisoned.str()
+       << "# EOF\n";
+   out.close();
+
+   if(std::rename(partial.c_str(), s_file.c_str()) != 0)
+   {
+     NS_LOG_ERROR("Cannot replace metrics snapshot " << s_file);
+   }
+}
+
+} // namespace ndn
+} // namespace ns3
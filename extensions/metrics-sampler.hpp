@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef METRICSSAMPLER_H
+#define METRICSSAMPLER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+//Progress of a long run while it is still going:
+//  with --MetricsFile=<path>, every --MetricsInterval of simulated time (1s by default) the whole file is
+//  replaced by an OpenMetrics text snapshot of the consumers' counters and the nodes' content stores (their
+//  CsPoisoningTracer counters), so `watch cat <path>`, `tail -F <path>` or a local scraper always sees one
+//  complete snapshot. The nodes are gone by the time the simulator's destroy hooks run, so the last
+//  snapshot is the one from the last interval before the simulation stopped.
+//
+//The consumers count into one flat array (APP_COUNTERS slots per app, handed out by RegisterApp), so
+//counting is an array increment and a sample walks the array and the node list once.
+class MetricsSampler
+{
+  public:
+     enum AppCounter {
+       INTERESTS_SENT, //every Interest: data, pursuit and key
+       DATA_RECEIVED,
+       EVIL_RECEIVED, //Data found bad (verification, size check or BadDataFilter)
+       KEY_FETCHES,
+       PURSUITS,
+       NACKS,
+       APP_COUNTERS
+     };
+
+     //slot for an app's counters, -1 when no MetricsFile is set (Count then does nothing)
+     //starts sampling with the first app of a simulation
+     static int32_t
+     RegisterApp(uint32_t node, uint32_t app);
+
+     static void
+     Count(int32_t slot, AppCounter counter)
+     {
+       if(slot >= 0)
+       {
+         s_appCounters[slot * APP_COUNTERS + counter]++;
+       }
+     }
+
+  private:
+     static void
+     Sample();
+
+     static void
+     WriteSnapshot();
+
+     //forget the apps (the next simulation in the process starts over)
+     static void
+     Finish();
+
+     static std::vector<uint64_t> s_appCounters;
+     static std::vector<uint32_t> s_appNodes; //node and app id of each slot
+     static std::vector<uint32_t> s_appIds;
+     static std::string s_file;
+     static bool s_started;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
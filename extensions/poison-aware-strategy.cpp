@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "poison-aware-strategy.hpp"
+#include "handler-profiler.hpp"
+
+#include "core/logger.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("PoisonAwareStrategy");
+
+const Name PoisonAwareStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/poison-aware");
+const double PoisonAwareStrategy::POISON_THRESHOLD = 0.5;
+const uint8_t PoisonAwareStrategy::MIN_SAMPLES;
+const size_t PoisonAwareStrategy::RECENT_NAMES;
+const uint8_t PoisonAwareStrategy::PROBE_INTERVAL;
+
+using ns3::ndn::HandlerProfiler;
+
+PoisonAwareStrategy::PoisonAwareStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder, name)
+{
+}
+
+PoisonAwareStrategy::~PoisonAwareStrategy()
+{
+}
+
+static bool
+canForwardToNextHop(const Face& inFace, const shared_ptr<pit::Entry>& pitEntry, const fib::NextHop& nexthop)
+{
+  return !wouldViolateScope(inFace, pitEntry->getInterest(), nexthop.getFace()) &&
+    canForwardToLegacy(*pitEntry, nexthop.getFace());
+}
+
+void
+PoisonAwareStrategy::afterReceiveInterest(const Face& inFace, const Interest& interest,
+                                          const shared_ptr<pit::Entry>& pitEntry)
+{
+  HandlerProfiler::Scope profile(HandlerProfiler::POISON_AWARE_STRATEGY);
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  bool isPursuit = !interest.getExclude().empty();
+
+  if (isPursuit) {
+    //only the faces whose Data is among the excluded ones handed out the poison
+    auto providers = m_lastProviders.find(interest.getName());
+    if (providers != m_lastProviders.end()) {
+      std::vector<Provider>& list = providers->second;
+      for (auto provider = list.begin(); provider != list.end();) {
+        if (interest.getExclude().isExcluded(provider->component)) {
+          add(getStats(fibEntry.getPrefix(), provider->face), &FaceStats::poisonedTwice, 2);
+          NFD_LOG_DEBUG(interest.getName() << " excluded Data from face " << provider->face);
+          provider = list.erase(provider);
+        }
+        else {
+          ++provider;
+        }
+      }
+      if (list.empty()) {
+        m_lastProviders.erase(providers);
+        m_lastProviderOrder.erase(std::find(m_lastProviderOrder.begin(), m_lastProviderOrder.end(),
+                                            interest.getName()));
+      }
+    }
+  }
+
+  std::vector<Face*> clean;
+  std::vector<Face*> probes;
+  Face* leastPoisoned = nullptr;
+  double leastRatio = 0;
+
+  PrefixStats& stats = m_stats[fibEntry.getPrefix()];
+  for (const fib::NextHop& nexthop : nexthops) {
+    if (!canForwardToNextHop(inFace, pitEntry, nexthop))
+      continue;
+
+    Face& outFace = nexthop.getFace();
+    FaceStats* faceStats = nullptr;
+    for (FaceStats& candidate : stats) {
+      if (candidate.face == outFace.getId()) {
+        faceStats = &candidate;
+        break;
+      }
+    }
+
+    if (isPursuit || faceStats == nullptr || !isPoisoned(*faceStats)) {
+      clean.push_back(&outFace);
+    }
+    else if (++faceStats->skipped >= PROBE_INTERVAL) {
+      faceStats->skipped = 0;
+      probes.push_back(&outFace);
+      NFD_LOG_DEBUG(interest.getName() << " probes poisoned face " << outFace.getId());
+    }
+    else if (leastPoisoned == nullptr || getPoisonRatio(*faceStats) < leastRatio) {
+      leastPoisoned = &outFace;
+      leastRatio = getPoisonRatio(*faceStats);
+    }
+  }
+
+  if (clean.empty() && leastPoisoned != nullptr) {
+    clean.push_back(leastPoisoned);
+  }
+  clean.insert(clean.end(), probes.begin(), probes.end());
+
+  for (Face* outFace : clean) {
+    this->sendInterest(pitEntry, *outFace, interest);
+  }
+
+  if (!hasPendingOutRecords(*pitEntry)) {
+    this->rejectPendingInterest(pitEntry);
+  }
+}
+
+void
+PoisonAwareStrategy::beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                                           const Face& inFace, const Data& data)
+{
+  HandlerProfiler::Scope profile(HandlerProfiler::POISON_AWARE_STRATEGY);
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  add(getStats(fibEntry.getPrefix(), inFace.getId()), &FaceStats::delivered, 1);
+
+  //the component a pursuit would exclude this Data by (the consumer looks right after its Interest name)
+  const Name& name = pitEntry->getName();
+  const Name& fullName = data.getFullName();
+  if (fullName.size() <= name.size())
+    return;
+  const name::Component& component = fullName.get(name.size());
+
+  auto inserted = m_lastProviders.insert(std::make_pair(name, std::vector<Provider>()));
+  if (inserted.second) {
+    m_lastProviderOrder.push_back(name);
+    if (m_lastProviderOrder.size() > RECENT_NAMES) {
+      m_lastProviders.erase(m_lastProviderOrder.front());
+      m_lastProviderOrder.pop_front();
+    }
+  }
+
+  std::vector<Provider>& list = inserted.first->second;
+  for (Provider& provider : list) {
+    if (provider.face == inFace.getId()) {
+      provider.component = component;
+      return;
+    }
+  }
+  list.push_back(Provider{inFace.getId(), component});
+}
+
+void
+PoisonAwareStrategy::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                                      const shared_ptr<pit::Entry>& pitEntry)
+{
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+  add(getStats(fibEntry.getPrefix(), inFace.getId()), &FaceStats::poisonedTwice, 1);
+
+  Strategy::afterReceiveNack(inFace, nack, pitEntry);
+}
+
+PoisonAwareStrategy::FaceStats&
+PoisonAwareStrategy::getStats(const Name& prefix, FaceId face)
+{
+  PrefixStats& stats = m_stats[prefix];
+  for (FaceStats& candidate : stats) {
+    if (candidate.face == face)
+      return candidate;
+  }
+
+  FaceStats fresh;
+  fresh.face = face;
+  fresh.delivered = 0;
+  fresh.poisonedTwice = 0;
+  fresh.skipped = 0;
+  stats.push_back(fresh);
+  return stats.back();
+}
+
+void
+PoisonAwareStrategy::add(FaceStats& stats, uint8_t FaceStats::*counter, uint8_t amount)
+{
+  if (stats.*counter > std::numeric_limits<uint8_t>::max() - amount) {
+    stats.delivered /= 2;
+    stats.poisonedTwice /= 2;
+  }
+  stats.*counter += amount;
+}
+
+bool
+PoisonAwareStrategy::isPoisoned(const FaceStats& stats)
+{
+  return stats.delivered >= MIN_SAMPLES && getPoisonRatio(stats) >= POISON_THRESHOLD;
+}
+
+double
+PoisonAwareStrategy::getPoisonRatio(const FaceStats& stats)
+{
+  return stats.poisonedTwice / (2.0 * std::max<uint8_t>(stats.delivered, 1));
+}
+
+} // namespace fw
+} // namespace nfd
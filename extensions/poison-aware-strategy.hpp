@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef POISONAWARESTRATEGY_H
+#define POISONAWARESTRATEGY_H
+
+#include "face/face.hpp"
+#include "fw/strategy.hpp"
+#include "fw/algorithm.hpp"
+
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace nfd {
+namespace fw {
+
+//Multicast that learns which upstream faces keep returning poisoned Data and stops sending to them.
+//
+//A consumer that got bad Data asks again with an Exclude. For the last RECENT_NAMES names, the strategy remembers
+//which faces satisfied the name and the component of their Data right after it (its extra component, or its
+//implicit digest). When such an Interest comes in, a face is charged one poisoned delivery under the Interest's
+//FIB prefix only if its component is among the excluded ones, so a face whose Data was good is never blamed
+//for a poisoned copy another consumer got elsewhere (e.g. from a CS hit); a Nack from a face counts as half a poisoned delivery. Every Data a
+//face brings counts as a delivery. Counters are 8 bit and halved together when one fills up, so old history
+//fades out.
+//
+//Interests go to every usable next hop whose poisoned/delivered ratio is below POISON_THRESHOLD (after
+//MIN_SAMPLES deliveries); if none is, only to the least poisoned one. Every PROBE_INTERVAL-th Interest a poisoned
+//face misses goes to it anyway, so a face whose cache got clean again earns its way back instead of being banned
+//for good. Interests with an Exclude (pursuits) still go to all next hops, since any of them may have the good
+//Data. With no history this is plain multicast.
+//
+//Install with StrategyChoiceHelper::Install<nfd::fw::PoisonAwareStrategy>(nodes, prefix).
+class PoisonAwareStrategy : public Strategy
+{
+public:
+  PoisonAwareStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual
+  ~PoisonAwareStrategy() override;
+
+  virtual void
+  afterReceiveInterest(const Face& inFace, const Interest& interest,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  virtual void
+  beforeSatisfyInterest(const shared_ptr<pit::Entry>& pitEntry,
+                        const Face& inFace, const Data& data) override;
+
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                   const shared_ptr<pit::Entry>& pitEntry) override;
+
+public:
+  static const Name STRATEGY_NAME;
+
+  static const double POISON_THRESHOLD;
+  static const uint8_t MIN_SAMPLES = 2;
+  static const size_t RECENT_NAMES = 1024;
+  static const uint8_t PROBE_INTERVAL = 16;
+
+private:
+  //16 bytes per face and prefix: the 64 bit FaceId, the counters and padding (the Nack half points are kept doubled)
+  struct FaceStats
+  {
+    FaceId face;
+    uint8_t delivered;
+    uint8_t poisonedTwice; //2 per poisoned delivery, 1 per Nack
+    uint8_t skipped; //Interests kept from the face since its last probe
+  };
+
+  typedef std::vector<FaceStats> PrefixStats;
+
+  //a face that satisfied a name, and the component after the name in the Data it brought
+  struct Provider
+  {
+    FaceId face;
+    name::Component component;
+  };
+
+  FaceStats&
+  getStats(const Name& prefix, FaceId face);
+
+  //adds to a counter, halving both of the face's counters first if it would overflow
+  static void
+  add(FaceStats& stats, uint8_t FaceStats::*counter, uint8_t amount);
+
+  static bool
+  isPoisoned(const FaceStats& stats);
+
+  //poisonedTwice / delivered, with no deliveries counting as one
+  static double
+  getPoisonRatio(const FaceStats& stats);
+
+private:
+  std::map<Name, PrefixStats> m_stats; //by FIB prefix
+  std::map<Name, std::vector<Provider>> m_lastProviders; //Interest name => faces its Data came from
+  std::deque<Name> m_lastProviderOrder; //names of m_lastProviders, oldest first, to bound it
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif
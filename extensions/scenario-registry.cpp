@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "scenario-registry.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+ScenarioRegistry::Registrar::Registrar(const char* name, Main main)
+{
+   GetScenarios()[name] = main;
+}
+
+ScenarioRegistry::ResetHook::ResetHook(Reset reset)
+{
+   GetResetHooks().push_back(reset);
+}
+
+void
+ScenarioRegistry::ResetRunState()
+{
+   for(Reset reset : GetResetHooks())
+   {
+     reset();
+   }
+}
+
+ScenarioRegistry::Main
+ScenarioRegistry::Find(const std::string& name)
+{
+   auto scenario = GetScenarios().find(name);
+   return scenario == GetScenarios().end() ? 0 : scenario->second;
+}
+
+const std::map<std::string, ScenarioRegistry::Main>&
+ScenarioRegistry::GetAll()
+{
+   return GetScenarios();
+}
+
+std::map<std::string, ScenarioRegistry::Main>&
+ScenarioRegistry::GetScenarios()
+{
+   //function-local so the registrars of the scenario files can use it whatever their initialisation order
+   static std::map<std::string, Main> scenarios;
+   return scenarios;
+}
+
+std::vector<ScenarioRegistry::Reset>&
+ScenarioRegistry::GetResetHooks()
+{
+   static std::vector<Reset> hooks;
+   return hooks;
+}
+
+} // namespace ndn
+} // namespace ns3
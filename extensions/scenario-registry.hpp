@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef SCENARIOREGISTRY_H
+#define SCENARIOREGISTRY_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+//Scenarios by name, for the single driver program (./waf configure --scenario-driver):
+//  every scenarios/*.cpp ends with NDN_SCENARIO_MAIN(<its main function>). Built on its own (the default)
+//  that is the program's main; built into the driver (NDN_SCENARIO_DRIVER, with NDN_SCENARIO_NAME set to
+//  the file name by wscript) it registers the function here instead, and ./build/ndn-scenarios <name>
+//  runs it (see scenarios/driver/scenario-driver.cpp).
+class ScenarioRegistry
+{
+  public:
+     typedef int (*Main)(int argc, char* argv[]);
+     typedef void (*Reset)();
+
+     //registers at static initialisation
+     struct Registrar
+     {
+       Registrar(const char* name, Main main);
+     };
+
+     //code that keeps per-run state in statics (files opened once, caches of global values) registers how
+     //to forget it, at static initialisation
+     struct ResetHook
+     {
+       ResetHook(Reset reset);
+     };
+
+     //the driver calls this between two scenarios run in one process
+     static void
+     ResetRunState();
+
+     //0 when there is no scenario of that name
+     static Main
+     Find(const std::string& name);
+
+     static const std::map<std::string, Main>&
+     GetAll();
+
+  private:
+     static std::map<std::string, Main>&
+     GetScenarios();
+
+     static std::vector<Reset>&
+     GetResetHooks();
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#ifdef NDN_SCENARIO_DRIVER
+#define NDN_SCENARIO_MAIN(function) \
+  static ns3::ndn::ScenarioRegistry::Registrar g_scenarioRegistrar(NDN_SCENARIO_NAME, &function);
+#else
+#define NDN_SCENARIO_MAIN(function) \
+  int main(int argc, char* argv[]) { return function(argc, argv); }
+#endif
+
+#endif
@@ -22,6 +22,12 @@
 
 
 #include "security-toy-client-app.hpp"
+#include "handler-profiler.hpp"
+#include "crypto-cost-model.hpp"
+#include "metrics-sampler.hpp"
+#include "cs-poisoning-tracer.hpp"
+#include "signing-key-chain.hpp"
+#include "helper/ndn-fib-helper.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "ns3/log.h"
@@ -32,6 +38,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include <ndn-cxx/security/validator.hpp>
 #include <iostream>
 
 using namespace std;
@@ -66,7 +73,117 @@ SecurityToyClientApp::GetTypeId()
                    StringValue("1024"), MakeIntegerAccessor(&SecurityToyClientApp::m_goodDataSize), 
                    MakeIntegerChecker<uint32_t>())
      .AddAttribute("DelayStart", "Seconds for how long client should wait to send first interest", StringValue("0"), 
-                   MakeDoubleAccessor(&SecurityToyClientApp::m_delayStartTime), MakeDoubleChecker<double>());
+                   MakeDoubleAccessor(&SecurityToyClientApp::m_delayStartTime), MakeDoubleChecker<double>())
+     .AddAttribute("StartJitter", "Max seconds of random jitter added to DelayStart (0 = no jitter)", StringValue("0"),
+                   MakeDoubleAccessor(&SecurityToyClientApp::m_startJitter), MakeDoubleChecker<double>(0.0))
+     .AddAttribute("InterestPoolSize", "Number of Interest objects kept for reuse (0 = allocate every Interest)",
+                   UintegerValue(8), MakeUintegerAccessor(&SecurityToyClientApp::m_interestPoolSize),
+                   MakeUintegerChecker<uint32_t>())
+     .AddAttribute("VerifySignatures", "Verify the data's signature against the fetched key "
+                   "(instead of treating data no bigger than GoodDataSize as evil)",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_verifySignatures),
+                   MakeBooleanChecker())
+     .AddAttribute("SimulateCryptoCost", "Take the calibrated verification cost (CryptoCostModel) in simulated "
+                   "time between the key arriving and acting on the verdict",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_simulateCryptoCost),
+                   MakeBooleanChecker())
+     .AddAttribute("KeyAlgorithm", "Signature algorithm of the data: rsa, ecdsa or sha256. Sets the cost model, and "
+                   "with VerifySignatures only sha256 takes a digest, anything else needs a key signature "
+                   "whose KeyLocator is under KeyName",
+                   StringValue("ecdsa"), MakeStringAccessor(&SecurityToyClientApp::m_keyAlgorithm),
+                   MakeStringChecker())
+     .AddAttribute("KeySize", "Key size for the cost model (0 = algorithm default)",
+                   UintegerValue(0), MakeUintegerAccessor(&SecurityToyClientApp::m_keySize),
+                   MakeUintegerChecker<uint32_t>())
+     .AddAttribute("CoalesceKeyFetches", "With VerifySignatures: send one key Interest for all consumers on the "
+                   "node waiting for the same key and verify their Data as a batch (KeyFetchCoalescer)",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_coalesceKeyFetches),
+                   MakeBooleanChecker())
+     .AddAttribute("UseBadDataFilter", "Keep the digests of Data that failed verification in the node's "
+                   "BadDataFilter and go straight to pursuit (no key fetch) for Data found in it",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_useBadDataFilter),
+                   MakeBooleanChecker())
+     .AddAttribute("NoticePrefix", "Prefix of the poisoning notices consumers send each other (empty = none)",
+                   StringValue(""), MakeNameAccessor(&SecurityToyClientApp::m_noticePrefix), MakeNameChecker())
+     .AddAttribute("NoticeIdentity", "Identity the notices are signed with",
+                   StringValue("/prefix/notice"), MakeNameAccessor(&SecurityToyClientApp::m_noticeIdentity),
+                   MakeNameChecker())
+     .AddAttribute("NoticeAlgorithm", "Notice signature: rsa or ecdsa (a sha256 digest proves nothing "
+                   "about the sender, so notices need a real key)",
+                   StringValue("ecdsa"), MakeStringAccessor(&SecurityToyClientApp::m_noticeAlgorithm),
+                   MakeStringChecker())
+     .AddAttribute("UseAnomalyPrefilter", "Score each Data on hop count, RTT and size against the verified Data "
+                   "so far (AnomalyPrefilter) and accept it without fetching the key when it does not look unusual",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_useAnomalyPrefilter),
+                   MakeBooleanChecker())
+     .AddAttribute("PrefilterThreshold", "Anomaly score (sum of deviations) from which Data gets verified",
+                   DoubleValue(3.0), MakeDoubleAccessor(&SecurityToyClientApp::m_prefilterThreshold),
+                   MakeDoubleChecker<double>(0.0))
+     .AddAttribute("PrefilterWarmup", "Number of verified Data before the prefilter skips any verification",
+                   UintegerValue(5), MakeUintegerAccessor(&SecurityToyClientApp::m_prefilterWarmup),
+                   MakeUintegerChecker<uint32_t>(1))
+     .AddAttribute("Speculative", "Hand Data to the application as soon as it arrives, verify it in the "
+                   "background and roll it back if it turns out bad (instead of holding it until the verdict)",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_speculative),
+                   MakeBooleanChecker())
+     .AddAttribute("ReportStats", "Print the prefilter's key fetches saved and detection accuracy at the end",
+                   BooleanValue(false), MakeBooleanAccessor(&SecurityToyClientApp::m_reportStats),
+                   MakeBooleanChecker())
+     .AddTraceSource("InterestsAllocated", "Number of Interest objects allocated so far",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_interestsAllocated),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("InterestsReused", "Number of Interests sent from a recycled pool object",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_interestsReused),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("KeyInterests", "Number of key Interests sent",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_keyInterests),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("KeyFetchLatency", "Time from the first key Interest for a Data to the key arriving",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_keyFetchLatency),
+                     "ns3::ndn::SecurityToyClientApp::VerificationLatencyCallback")
+     .AddTraceSource("DataVerified", "Number of Data with a verification verdict",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_dataVerified),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("VerificationLatency", "Time from a Data arriving to its verification verdict",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_verificationLatency),
+                     "ns3::ndn::SecurityToyClientApp::VerificationLatencyCallback")
+     .AddTraceSource("KnownBadDropped", "Number of Data dropped as known bad by the BadDataFilter",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_knownBadDropped),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("NoticesSent", "Number of poisoning notices sent",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_noticesSent),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("NoticesReceived", "Number of poisoning notices received for my prefix",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_noticesReceived),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("NoticesRejected", "Number of notices for my prefix dropped because their signature "
+                     "did not check out against the NoticeIdentity key",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_noticesRejected),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("PrefilterTrusted", "Number of Data the prefilter accepted unverified (key fetches saved)",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_prefilterTrusted),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("PrefilterSuspicious", "Number of Data the warm prefilter sent to verification",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_prefilterSuspicious),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("PrefilterMissed", "Number of evil Data the prefilter accepted",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_prefilterMissed),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("PrefilterFalseAlarms", "Number of good Data the prefilter sent to verification",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_prefilterFalseAlarms),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("TimeToFirstByte", "Time from the first Interest for a Data to handing it to the application",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_timeToFirstByte),
+                     "ns3::ndn::SecurityToyClientApp::DeliveryTimeCallback")
+     .AddTraceSource("TimeToVerified", "Time from the first Interest for a Data to its verification verdict",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_timeToVerified),
+                     "ns3::ndn::SecurityToyClientApp::DeliveryTimeCallback")
+     .AddTraceSource("Rollback", "Speculatively delivered Data failed verification, with the time it was in use",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_rollback),
+                     "ns3::ndn::SecurityToyClientApp::DeliveryTimeCallback")
+     .AddTraceSource("Rollbacks", "Number of speculatively delivered Data rolled back",
+                     MakeTraceSourceAccessor(&SecurityToyClientApp::m_rollbacks),
+                     "ns3::TracedValueCallback::Uint64");
    return tid;
 }
 
@@ -82,6 +199,8 @@ SecurityToyClientApp::SecurityToyClientApp()
    m_waitTime = 2.0; //suggested is reaction time is at least half of this wait time else infinite loop mode...
    m_reactionTime = 1.0;
    m_delayStartTime = 0;
+   m_startJitter = 0;
+   m_jitterRand = CreateObject<UniformRandomVariable>();
    m_firstTime = true;
    m_verificationMode = false;
    m_pursuitMode = false;
@@ -89,6 +208,45 @@ SecurityToyClientApp::SecurityToyClientApp()
    m_seqMax = std::numeric_limits<uint32_t>::max(); //needed to be able to send the packets
    m_seq = 1; //start at 1 for the data packets
    m_keyRequestInterestSeq = 0;
+   m_interestPoolSize = 8;
+   m_interestsAllocated = 0;
+   m_interestsReused = 0;
+   m_verifySignatures = false;
+   m_simulateCryptoCost = false;
+   m_keyAlgorithm = "ecdsa";
+   m_expectDigest = false;
+   m_keySize = 0;
+   m_coalesceKeyFetches = false;
+   m_awaitingVerdict = false;
+   m_keyInterests = 0;
+   m_dataVerified = 0;
+   m_useBadDataFilter = false;
+   m_knownBadDropped = 0;
+   m_noticeAlgorithm = "ecdsa";
+   m_noticesSent = 0;
+   m_noticesReceived = 0;
+   m_noticesRejected = 0;
+   m_useAnomalyPrefilter = false;
+   m_prefilterThreshold = 3.0;
+   m_prefilterWarmup = 5;
+   m_prefilterTrusted = 0;
+   m_prefilterSuspicious = 0;
+   m_prefilterMissed = 0;
+   m_prefilterFalseAlarms = 0;
+   m_reportStats = false;
+   m_speculative = false;
+   m_deliveredUnverified = false;
+   m_rollbacks = 0;
+   m_metricsSlot = -1;
+}
+
+int64_t
+SecurityToyClientApp::AssignStreams(int64_t stream)
+{
+   //stream + 0 => Interest nonces, stream + 1 => start jitter
+   m_rand->SetStream(stream);
+   m_jitterRand->SetStream(stream + 1);
+   return 2;
 }
 
 
@@ -102,11 +260,19 @@ SecurityToyClientApp::SecurityToyClientApp()
 void
 SecurityToyClientApp::SendPacket()
 {
+  HandlerProfiler::Scope profile(HandlerProfiler::CLIENT_SEND_PACKET);
+
   if (!m_active)
     return;
 
   NS_LOG_FUNCTION_NOARGS();
 
+  if (m_verifyEvent.IsRunning()) {
+    //still busy verifying, the verdict decides what to ask for next
+    SecurityToyClientApp::ScheduleNextPacket();
+    return;
+  }
+
   shared_ptr<Interest> interest;
 
   uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
@@ -148,24 +314,36 @@ SecurityToyClientApp::SendPacket()
   {
    //NS_LOG_INFO("Making a Packet w/ sequence number" << seq);
 
-   shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-   nameWithSequence->appendSequenceNumber(seq);
-
-   m_originalInterestName = nameWithSequence;
+   //prefix is already encoded in m_interestName, only the sequence number component is new. The copies into
+   //m_originalInterestName and the pooled Interest reuse the component storage of the previous send, but
+   //encoding the sequence number still allocates a small buffer for every Interest (ndn-cxx 0.5 cannot
+   //rewrite a component in place), and so does the Interest's wire encoding on its way to the forwarder
+   m_originalInterestName = m_interestName;
+   m_originalInterestName.appendSequenceNumber(seq);
 
-   // shared_ptr<Interest> interest = make_shared<Interest> ();
-   interest = make_shared<Interest>();
+   interest = AcquireInterest();
    m_originalNonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
    interest->setNonce(m_originalNonce);
-   interest->setName(*nameWithSequence);
-   time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-   interest->setInterestLifetime(interestLifeTime);
+   interest->setName(m_originalInterestName);
+   interest->setInterestLifetime(m_interestLifetimeMs);
+
+   auto noticed = m_noticedBad.find(seq);
+   if(noticed != m_noticedBad.end())
+   {
+      //another consumer already found the bad Data for this one: ask past it from the start
+      m_pursuitExclude = Exclude();
+      m_pursuitExclude.excludeOne(noticed->second);
+      interest->setExclude(m_pursuitExclude);
+      m_noticedBad.erase(noticed);
+   }
+   else
+   {
+      interest->setExclude(m_noExclude);
+   }
 
    // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
    //this will now make every even interest a request for data...
-   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-   NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+   NDN_EVENT_LOG(m_eventLog, EVENT_INTEREST_SENT, seq, 0, m_originalNonce);
 
    //NS_LOG_INFO("I currently have app link: " << m_appLink);
   }
@@ -173,34 +351,38 @@ SecurityToyClientApp::SendPacket()
   {
     if(m_pursuitMode && !m_verificationMode)
     {
-      cout << "in pursuit mode!" << endl;
       //I received a bad data packet => I retransmit my previous interest but with EF flag set! (And I have not started 
       //verification yet)
-      interest = make_shared<Interest>();
+      interest = AcquireInterest();
       interest->setNonce(m_originalNonce);
-      interest->setName(*m_originalInterestName);
-      time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-      interest->setInterestLifetime(interestLifeTime);
-
-      Exclude excludeSection = Exclude();
-      Name evilDataName = m_evilPacket->getName();
-      name::Component excludeItem = evilDataName.get(3);
-      excludeSection.excludeOne(excludeItem);
-      interest->setExclude(excludeSection);
-
-      NS_LOG_DEBUG("Interest with Exclude: " << interest->toUri()); 
+      interest->setName(m_originalInterestName);
+      interest->setInterestLifetime(m_interestLifetimeMs);
+      interest->setExclude(m_pursuitExclude); //built once when the evil packet came in
 
-      NS_LOG_INFO("> Requesting new data for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
+      NDN_EVENT_LOG(m_eventLog, EVENT_PURSUIT_SENT, seq, 0, m_originalNonce);
       //cout << "> Requesting new data for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId() << endl;
     }
     else
     {
-      interest = make_shared<Interest>();
+      if(m_keyCoalescer && !m_keyCoalescer->ClaimFetch(m_keyName))
+      {
+        //another consumer on the node is fetching the key (or it is cached): my verdict comes with it
+        SecurityToyClientApp::ScheduleNextPacket();
+        return;
+      }
+
+      interest = AcquireInterest();
       interest->setNonce(m_rand->GetValue(0,std::numeric_limits<uint32_t>::max()));
       interest->setName(m_keyName);
-      time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-      interest->setInterestLifetime(interestLifeTime);
-      NS_LOG_INFO("> Interest for " << seq << ", is a Key Request Interest");
+      interest->setInterestLifetime(m_interestLifetimeMs);
+      interest->setExclude(m_noExclude);
+      NDN_EVENT_LOG(m_eventLog, EVENT_KEY_INTEREST_SENT, seq, 0, interest->getNonce());
+      m_keyInterests++;
+      MetricsSampler::Count(m_metricsSlot, MetricsSampler::KEY_FETCHES);
+      if(m_keyRequestedAt.IsZero())
+      {
+        m_keyRequestedAt = Simulator::Now();
+      }
       //cout << "> Interest for " << seq << ", is a Key Request Interest" << endl;
       
       m_seqRetxCounts[seq] = 0;
@@ -216,17 +398,41 @@ SecurityToyClientApp::SendPacket()
 
   m_rtt->SentSeq(SequenceNumber32(seq), 1);
 
+  MetricsSampler::Count(m_metricsSlot, MetricsSampler::INTERESTS_SENT);
   m_transmittedInterests(interest, this, m_face);
-  m_appLink->onReceiveInterest(*interest);
+  {
+    HandlerProfiler::Scope forwarding(HandlerProfiler::APP_FACE);
+    m_appLink->onReceiveInterest(*interest);
+  }
 
   //NS_LOG_INFO("Created Interest: " << *interest);
 
   SecurityToyClientApp::ScheduleNextPacket();
 }
 
+shared_ptr<Interest>
+SecurityToyClientApp::AcquireInterest()
+{
+  //an Interest only I still point to has left the forwarder (PIT, queues) and can be refilled
+  for (auto& pooled : m_interestPool) {
+    if (pooled.unique()) {
+      m_interestsReused++;
+      return pooled;
+    }
+  }
+
+  auto interest = make_shared<Interest>();
+  m_interestsAllocated++;
+  if (m_interestPool.size() < m_interestPoolSize) {
+    m_interestPool.push_back(interest);
+  }
+  return interest;
+}
+
 void
 SecurityToyClientApp::OnData(shared_ptr<const Data> data)
 {
+  HandlerProfiler::Scope profile(HandlerProfiler::CLIENT_ON_DATA);
 
   if (!m_active)
     return;
@@ -249,24 +455,37 @@ SecurityToyClientApp::OnData(shared_ptr<const Data> data)
 
   if(!m_verificationMode)
   {
+     if(m_keyCoalescer && m_keyName.isPrefixOf(data->getName()))
+     {
+        //a key I fetched for the node after my own Data was already answered by another consumer's key
+        m_keyCoalescer->OnKeyData(m_keyName, *data);
+        return;
+     }
+
+     MetricsSampler::Count(m_metricsSlot, MetricsSampler::DATA_RECEIVED);
      uint32_t seq = data->getName().at(2).toSequenceNumber();
-     NS_LOG_INFO("< DATA for " << seq << " with name " << data->getName());
-     cout << "< DATA for " << seq << " with name" << data->getName() << endl;
      int hopCount = 0;
      auto hopCountTag = data->getTag<lp::HopCountTag>();
      if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
         hopCount = *hopCountTag;
       }
-      NS_LOG_DEBUG("Hop count: " << hopCount);
+     NDN_EVENT_LOG(m_eventLog, EVENT_DATA_RECEIVED, seq, hopCount, data->getContent().size());
+
+     AnomalyPrefilter::Features features = {static_cast<double>(hopCount), 0,
+                                            static_cast<double>(data->getContent().size())};
 
      SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
      if (entry != m_seqLastDelay.end()) {
         m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
+        features.rtt = (Simulator::Now() - entry->time).GetSeconds();
      }
 
      entry = m_seqFullDelay.find(seq);
      if (entry != m_seqFullDelay.end()) {
          m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+         if (!m_pursuitMode) {
+            m_requestedAt = entry->time; //pursuit Interests keep counting from the original one
+         }
      }
 
      m_originalSequenceNumber = seq;
@@ -278,20 +497,61 @@ SecurityToyClientApp::OnData(shared_ptr<const Data> data)
      m_seqTimeouts.erase(seq);
      m_retxSeqs.erase(seq);
 
+     if(m_badDataFilter && m_badDataFilter->Contains(data->getFullName().get(-1)))
+     {
+        //the node already knows this one is bad: no key fetch, go after the good one right away
+        NDN_EVENT_LOG(m_eventLog, EVENT_KNOWN_BAD_DROPPED, seq, 0, data->getContent().size());
+        m_knownBadDropped++;
+        MetricsSampler::Count(m_metricsSlot, MetricsSampler::EVIL_RECEIVED);
+        MetricsSampler::Count(m_metricsSlot, MetricsSampler::PURSUITS);
+        m_evilPacket = data;
+        m_lastPacketEvil = true;
+        ExcludeBadData(*data);
+        m_pursuitMode = true;
+        return;
+     }
+
+     if(m_useAnomalyPrefilter && PrefilterTrusts(*data, seq, features))
+     {
+        Deliver();
+        return;
+     }
+     m_pendingFeatures = features;
+
      m_verificationMode = true;
+     m_deliveredUnverified = m_speculative;
+     if(m_speculative)
+     {
+        Deliver();
+     }
+
+     if(m_verifySignatures)
+     {
+        //good or evil is only known once the key is in (VerifyReceivedData / OnVerdict)
+        m_receivedData = data;
+        m_receivedAt = Simulator::Now();
+        if(m_keyCoalescer)
+        {
+           m_awaitingVerdict = true;
+           m_keyCoalescer->Wait(m_keyName, data, m_expectDigest, MakeCallback(&SecurityToyClientApp::OnVerdict, this));
+        }
+        return;
+     }
 
      Block dataContent = data->getContent();
      //this seems really really hacky... but sadly I don't have a way around this b/c somehow returned data will have an extra 4 bytes...
      if(dataContent.size() <= m_goodDataSize)
      {
         //somehow evil packet... let's use block size since not easy to store a string in the block.
-        NS_LOG_DEBUG("Received Evil Packet for " << seq << " with size " << dataContent.size());
+        NDN_EVENT_LOG(m_eventLog, EVENT_EVIL_DATA, seq, 0, dataContent.size());
         m_evilPacket = data;
         m_lastPacketEvil = true;
+
+        //the pursuit Interests for this seq all exclude the same component, so build it once here
+        ExcludeBadData(*data);
      }
      else
      {
-        NS_LOG_DEBUG("Received Good Packet for " << seq << " with size " << dataContent.size());
         m_lastPacketEvil = false;
      }
 
@@ -299,13 +559,27 @@ SecurityToyClientApp::OnData(shared_ptr<const Data> data)
   else
   { //in verification mode => assumes data received is the key...
 
-     NS_LOG_INFO("> Data for Key Request " << m_keyRequestInterestSeq << " for Data packet " << m_originalSequenceNumber);
+     if(m_verifyEvent.IsRunning())
+     {
+        //already verifying with an earlier copy of the key (the node's other consumers may still want it)
+        if(m_keyCoalescer)
+        {
+           m_keyCoalescer->OnKeyData(m_keyName, *data);
+        }
+        return;
+     }
+
      int hopCount = 0;
      auto hopCountTag = data->getTag<lp::HopCountTag>();
      if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
         hopCount = *hopCountTag;
      }
-     NS_LOG_DEBUG("Hop count: " << hopCount);
+     NDN_EVENT_LOG(m_eventLog, EVENT_KEY_RECEIVED, m_originalSequenceNumber, hopCount, m_keyRequestInterestSeq);
+     if(!m_keyRequestedAt.IsZero())
+     {
+        m_keyFetchLatency(this, m_originalSequenceNumber, Simulator::Now() - m_keyRequestedAt);
+        m_keyRequestedAt = Time();
+     }
 
     m_seqRetxCounts.erase(m_keyRequestInterestSeq);
     m_seqFullDelay.erase(m_keyRequestInterestSeq);
@@ -316,15 +590,108 @@ SecurityToyClientApp::OnData(shared_ptr<const Data> data)
     //ack receive of key interest data response (else it gets retransmitted)
     m_rtt->AckSeq(SequenceNumber32(m_keyRequestInterestSeq));
 
+    if(m_keyCoalescer)
+    {
+       //verifies everything on the node waiting for this key, my verdict comes back through OnVerdict
+       m_keyCoalescer->OnKeyData(m_keyName, *data);
+       return;
+    }
+
+    //without real verification every key arrival stands for one verification
+    bool verified = m_verifySignatures ? VerifyReceivedData(*data) : true;
+
+    if(m_simulateCryptoCost && verified)
+    {
+       m_verifyEvent = Simulator::Schedule(m_verifyDelay, &SecurityToyClientApp::FinishVerification, this);
+    }
+    else
+    {
+       FinishVerification();
+    }
+  } 
+}
+
+bool
+SecurityToyClientApp::PrefilterTrusts(const Data& data, uint32_t seq, const AnomalyPrefilter::Features& features)
+{
+  if(!m_prefilter.IsWarm(m_prefilterWarmup))
+    return false;
+
+  //only used to score the prefilter, what happens to the Data is up to the score alone
+  bool evil = data.getContent().size() <= m_goodDataSize;
+  double score = m_prefilter.Score(features);
+  if(score >= m_prefilterThreshold)
+  {
+     m_prefilterSuspicious++;
+     if(!evil)
+     {
+        m_prefilterFalseAlarms++;
+     }
+     return false;
+  }
+
+  NDN_EVENT_LOG(m_eventLog, EVENT_PREFILTER_TRUSTED, seq, 0, static_cast<uint32_t>(score * 1000));
+  m_prefilterTrusted++;
+  if(evil)
+  {
+     m_prefilterMissed++;
+  }
+
+  //accepted as it is, same as a good verdict (not learnt from: unverified Data must not move the baseline)
+  m_lastPacketEvil = false;
+  m_rtt->AckSeq(SequenceNumber32(seq));
+  m_pursuitMode = false;
+  return true;
+}
+
+void
+SecurityToyClientApp::Deliver()
+{
+  //no application sits on top of the toy consumer, delivering is the trace
+  m_deliveredAt = Simulator::Now();
+  m_timeToFirstByte(this, m_originalSequenceNumber, m_deliveredAt - m_requestedAt);
+}
+
+void
+SecurityToyClientApp::FinishVerification()
+{
     m_verificationMode = false;
+    m_timeToVerified(this, m_originalSequenceNumber, Simulator::Now() - m_requestedAt);
+
+    if(m_deliveredUnverified && m_lastPacketEvil)
+    {
+       //the application already used it: take it back, the pursuit delivers the good one again
+       Time inUse = Simulator::Now() - m_deliveredAt;
+       NDN_EVENT_LOG(m_eventLog, EVENT_ROLLBACK, m_originalSequenceNumber, 0,
+                     static_cast<uint32_t>(inUse.GetMicroSeconds()));
+       m_rollbacks++;
+       m_rollback(this, m_originalSequenceNumber, inUse);
+    }
+    else if(!m_deliveredUnverified && !m_lastPacketEvil)
+    {
+       Deliver();
+    }
+    m_deliveredUnverified = false;
+
+    if(!m_lastPacketEvil && m_useAnomalyPrefilter)
+    {
+       m_prefilter.Learn(m_pendingFeatures);
+    }
+
+    if(m_lastPacketEvil && m_badDataFilter && m_evilPacket)
+    {
+       m_badDataFilter->Insert(m_evilPacket->getFullName().get(-1));
+    }
+    if(m_lastPacketEvil && !m_noticePrefix.empty() && m_evilPacket)
+    {
+       PublishNotice(*m_evilPacket);
+    }
 
     //should only ACK original packet if it wasn't evil... else set pursuit mode to true
     if(!m_lastPacketEvil)
     {
 
        //to true (and have the previously sent data stored for exclude later)
-       NS_LOG_INFO("Acknowledging:" << m_originalSequenceNumber);
-
        //ack original packet
        m_rtt->AckSeq(SequenceNumber32(m_originalSequenceNumber));
 
@@ -332,22 +699,183 @@ SecurityToyClientApp::OnData(shared_ptr<const Data> data)
     }
     else
     {
-       NS_LOG_INFO("Pursuing new packet for " << m_originalSequenceNumber);
+       NDN_EVENT_LOG(m_eventLog, EVENT_PURSUIT_STARTED, m_originalSequenceNumber, 0, 0);
+       MetricsSampler::Count(m_metricsSlot, MetricsSampler::EVIL_RECEIVED);
+       MetricsSampler::Count(m_metricsSlot, MetricsSampler::PURSUITS);
        m_pursuitMode = true;
     }
-  } 
+}
+
+bool
+SecurityToyClientApp::VerifyReceivedData(const Data& keyData)
+{
+  if(!m_receivedData)
+    return false;
+
+  bool cached = false;
+  bool good = m_verificationCache->Verify(*m_receivedData, keyData.getContent(), m_keyName, m_expectDigest,
+                                         &cached);
+  ApplyVerdict(good);
+  return !cached;
+}
+
+void
+SecurityToyClientApp::OnVerdict(shared_ptr<const Data> data, bool good, bool cached)
+{
+  //a verdict for Data I already gave up on (NACK) must not land on whatever I received since
+  if(!m_awaitingVerdict || data != m_receivedData)
+    return;
+  m_awaitingVerdict = false;
+  m_keyRequestedAt = Time(); //answered through the node's other consumers (if I asked at all)
+
+  //the key may have come through another consumer, so my own key request is done too
+  m_seqRetxCounts.erase(m_keyRequestInterestSeq);
+  m_seqFullDelay.erase(m_keyRequestInterestSeq);
+  m_seqLastDelay.erase(m_keyRequestInterestSeq);
+  m_seqTimeouts.erase(m_keyRequestInterestSeq);
+  m_retxSeqs.erase(m_keyRequestInterestSeq);
+
+  ApplyVerdict(good);
+
+  if(m_simulateCryptoCost && !cached)
+  {
+     m_verifyEvent = Simulator::Schedule(m_verifyDelay, &SecurityToyClientApp::FinishVerification, this);
+  }
+  else
+  {
+     FinishVerification();
+  }
+}
+
+void
+SecurityToyClientApp::ApplyVerdict(bool good)
+{
+  if(!m_receivedData)
+    return;
+
+  NDN_EVENT_LOG(m_eventLog, EVENT_SIGNATURE_CHECKED, m_originalSequenceNumber, good ? 1 : 0, 0);
+  m_dataVerified++;
+  m_verificationLatency(this, m_originalSequenceNumber, Simulator::Now() - m_receivedAt);
+
+  m_lastPacketEvil = !good;
+  if(!good)
+  {
+     m_evilPacket = m_receivedData;
+     ExcludeBadData(*m_receivedData);
+  }
+  m_receivedData.reset();
+}
+
+void
+SecurityToyClientApp::PublishNotice(const Data& badData)
+{
+  Name noticeName(m_noticePrefix);
+  noticeName.append(badData.getFullName());
+
+  //not pooled: the signature components make every notice name different anyway
+  auto notice = make_shared<Interest>(noticeName);
+  notice->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  notice->setInterestLifetime(m_interestLifetimeMs);
+  SigningKeyChain::Get().Sign(*notice, m_noticeSigningInfo);
+
+  NDN_EVENT_LOG(m_eventLog, EVENT_NOTICE_SENT, m_originalSequenceNumber, 0, 0);
+  m_noticesSent++;
+
+  m_transmittedInterests(notice, this, m_face);
+  m_appLink->onReceiveInterest(*notice);
+}
+
+void
+SecurityToyClientApp::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  //<NoticePrefix>/<bad Data full name>/<signature info>/<signature value>
+  const Name& name = interest->getName();
+  size_t badNameStart = m_noticePrefix.size();
+  if(m_noticePrefix.empty() || !m_noticePrefix.isPrefixOf(name) || name.size() < badNameStart + 2)
+    return;
+
+  Name badName = name.getSubName(badNameStart, name.size() - badNameStart - 2);
+  size_t seqIndex = m_interestName.size();
+  if(!m_interestName.isPrefixOf(badName) || badName.size() < seqIndex + 2
+     || !badName.get(seqIndex).isSequenceNumber())
+    return; //someone else's data, or nothing to exclude
+
+  //anyone can send an Interest under the notice prefix; only notices signed with the notice key count
+  if(!VerifyNotice(*interest))
+  {
+    NS_LOG_DEBUG("dropping notice with a bad signature: " << name);
+    m_noticesRejected++;
+    return;
+  }
+
+  uint32_t seq = badName.get(seqIndex).toSequenceNumber();
+  m_noticesReceived++;
+  if(seq >= m_seq)
+  {
+    m_noticedBad[seq] = badName.get(seqIndex + 1); //not asked for yet
+  }
+  NDN_EVENT_LOG(m_eventLog, EVENT_NOTICE_RECEIVED, seq, 0, 0);
+
+  if(m_badDataFilter)
+  {
+    m_badDataFilter->Insert(badName.get(-1)); //the implicit digest
+  }
+}
+
+bool
+SecurityToyClientApp::VerifyNotice(const Interest& notice)
+{
+  if(!m_noticeKey)
+    return false;
+
+  const Name& name = notice.getName();
+  try
+  {
+    Signature signature(name.get(-2).blockFromValue(), name.get(-1).blockFromValue());
+    if(signature.getType() == ::ndn::tlv::DigestSha256 || !signature.hasKeyLocator()
+       || signature.getKeyLocator().getType() != ::ndn::KeyLocator::KeyLocator_Name
+       || !m_noticeIdentity.isPrefixOf(signature.getKeyLocator().getName()))
+      return false;
+  }
+  catch(const ::ndn::tlv::Error& e)
+  {
+    return false; //the last two components are not a signature at all
+  }
+  return ::ndn::Validator::verifySignature(notice, *m_noticeKey);
+}
+
+void
+SecurityToyClientApp::ExcludeBadData(const Data& data)
+{
+  m_pursuitExclude = Exclude();
+  m_pursuitExclude.excludeOne(data.getFullName().get(m_originalInterestName.size()));
 }
 
 void
 SecurityToyClientApp::OnNack(shared_ptr<const lp::Nack> nack)
 {
+  HandlerProfiler::Scope profile(HandlerProfiler::CLIENT_ON_NACK);
+
   Consumer::OnNack(nack);//for the logging...
+  NDN_EVENT_LOG(m_eventLog, EVENT_NACK_RECEIVED, m_originalSequenceNumber, 0, nack->getReason());
+  MetricsSampler::Count(m_metricsSlot, MetricsSampler::NACKS);
   //don't retransmit. Wait and schedule next packet
 
   //if in verification Mode and received a NACK for the signature, set verification mode to false. (failed verification)
   if(m_verificationMode)
   {
 	m_verificationMode = false;
+        m_keyRequestedAt = Time();
+  }
+
+  //no verdict is coming for the Data parked with the coalescer any more
+  if(m_awaitingVerdict)
+  {
+        m_keyCoalescer->Cancel(m_keyName, m_receivedData);
+        m_awaitingVerdict = false;
+        m_receivedData.reset();
   }
 
   //if received a NACK while in pursuit mode => there's no other packet in network. so give up.
@@ -360,9 +888,17 @@ SecurityToyClientApp::OnNack(shared_ptr<const lp::Nack> nack)
 void
 SecurityToyClientApp::ScheduleNextPacket()
 {
+   HandlerProfiler::Scope profile(HandlerProfiler::CLIENT_SCHEDULE_NEXT_PACKET);
+
    if(m_firstTime)
    {
-	m_sendEvent = Simulator::Schedule(Seconds(m_delayStartTime), &SecurityToyClientApp::SendPacket, this);
+        //only draw when jitter is on so default runs keep their old start times
+        double startTime = m_delayStartTime;
+        if(m_startJitter > 0)
+        {
+          startTime += m_jitterRand->GetValue(0, m_startJitter);
+        }
+	m_sendEvent = Simulator::Schedule(Seconds(startTime), &SecurityToyClientApp::SendPacket, this);
         m_firstTime = false;
    }
    else if(!m_sendEvent.IsRunning())
@@ -380,7 +916,80 @@ SecurityToyClientApp::ScheduleNextPacket()
    }
 }
 
-//will call parent StartApplication & StopApplication
+//parent StartApplication & StopApplication do the real work, I just look after my event log
+void
+SecurityToyClientApp::StartApplication()
+{
+   Consumer::StartApplication();
+   m_eventLog.Open(GetNode()->GetId(), GetId());
+   if(m_metricsSlot < 0)
+   {
+     m_metricsSlot = MetricsSampler::RegisterApp(GetNode()->GetId(), GetId());
+   }
+   CsPoisoningTracer::StartOutput();
+
+   //attributes are final by now, convert the lifetime once instead of on every send
+   m_interestLifetimeMs = time::milliseconds(m_interestLifeTime.GetMilliSeconds());
+   m_interestPool.reserve(m_interestPoolSize);
+
+   if(m_verifySignatures)
+   {
+     m_verificationCache = VerificationCache::Get(GetNode());
+     m_expectDigest = SigningKeyChain::ParseAlgorithm(m_keyAlgorithm) == SigningKeyChain::SHA256;
+     if(m_coalesceKeyFetches)
+     {
+       m_keyCoalescer = KeyFetchCoalescer::Get(GetNode());
+     }
+   }
+   else if(m_coalesceKeyFetches)
+   {
+     NS_LOG_WARN("CoalesceKeyFetches needs VerifySignatures, ignored");
+   }
+   if(m_useBadDataFilter)
+   {
+     m_badDataFilter = BadDataFilter::Get(GetNode());
+   }
+   if(!m_noticePrefix.empty())
+   {
+     //notices from the other consumers reach me through my face
+     FibHelper::AddRoute(GetNode(), m_noticePrefix, m_face, 0);
+     SigningKeyChain::Algorithm noticeAlgorithm = SigningKeyChain::ParseAlgorithm(m_noticeAlgorithm);
+     if(noticeAlgorithm == SigningKeyChain::SHA256)
+     {
+       NS_FATAL_ERROR("NoticeAlgorithm sha256 cannot be checked against a key, use rsa or ecdsa");
+     }
+     m_noticeSigningInfo = SigningKeyChain::Get().Prepare(m_noticeIdentity, noticeAlgorithm, 0);
+     //every consumer signs with the same notice identity, so its key is the one notices are checked against
+     ConstBufferPtr keyBits = SigningKeyChain::Get().GetPublicKeyBits(m_noticeIdentity);
+     m_noticeKey.reset(new ::ndn::security::v1::PublicKey(keyBits->buf(), keyBits->size()));
+   }
+   if(m_simulateCryptoCost)
+   {
+     m_verifyDelay = CryptoCostModel::GetVerifyDelay(SigningKeyChain::ParseAlgorithm(m_keyAlgorithm), m_keySize);
+   }
+}
+
+void
+SecurityToyClientApp::StopApplication()
+{
+   m_eventLog.Flush();
+   Simulator::Cancel(m_verifyEvent);
+   if(m_reportStats && m_useAnomalyPrefilter)
+   {
+     //evil Data = suspicious and evil + missed
+     uint64_t flaggedEvil = m_prefilterSuspicious.Get() - m_prefilterFalseAlarms.Get();
+     uint64_t evil = flaggedEvil + m_prefilterMissed.Get();
+     uint64_t judged = m_prefilterTrusted.Get() + m_prefilterSuspicious.Get();
+     uint64_t wrong = m_prefilterMissed.Get() + m_prefilterFalseAlarms.Get();
+     std::cout << "AnomalyPrefilter node(" << GetNode()->GetId() << ") app(" << GetId() << "): "
+               << "key-fetches-saved=" << m_prefilterTrusted << " suspicious=" << m_prefilterSuspicious
+               << " missed-evil=" << m_prefilterMissed << " false-alarms=" << m_prefilterFalseAlarms
+               << " detection-rate=" << (evil > 0 ? double(flaggedEvil) / evil : 1.0)
+               << " accuracy=" << (judged > 0 ? double(judged - wrong) / judged : 1.0)
+               << std::endl;
+   }
+   Consumer::StopApplication();
+}
 
 
 } // namespace ndn
@@ -24,6 +24,14 @@
 #define SECURITYTOYCLIENT_H
 
 #include "ns3/ndnSIM/apps/ndn-consumer.hpp"
+#include "event-ring-logger.hpp"
+#include "verification-cache.hpp"
+#include "key-fetch-coalescer.hpp"
+#include "bad-data-filter.hpp"
+#include "anomaly-prefilter.hpp"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+#include <map>
 #include <vector>
 #include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
@@ -51,11 +59,77 @@ class SecurityToyClientApp : public Consumer
      virtual void
      OnNack(shared_ptr<const lp::Nack> nack);
 
+     //only poisoning notices (NoticePrefix) come in as Interests
+     virtual void
+     OnInterest(shared_ptr<const Interest> interest);
+
+     //signature of the VerificationLatency trace source
+     typedef void (*VerificationLatencyCallback)(Ptr<App> app, uint32_t seqno, Time latency);
+
+     //signature of the TimeToFirstByte, TimeToVerified and Rollback trace sources
+     typedef void (*DeliveryTimeCallback)(Ptr<App> app, uint32_t seqno, Time time);
+
+     //pins the nonce and start jitter generators to fixed RNG substreams (so paired runs share them)
+     //returns the number of streams used
+     int64_t
+     AssignStreams(int64_t stream);
+
   protected:
+     virtual void
+     StartApplication();
+
+     virtual void
+     StopApplication();
 
      virtual void
      ScheduleNextPacket();
 
+     //hands out an Interest to fill in: a pooled one nobody else holds anymore, else a new one
+     shared_ptr<Interest>
+     AcquireInterest();
+
+     //VerifySignatures: checks the Data waiting for its key against the key Data that just came in
+     //and sets up the pursuit if it failed; returns false when the result came from the node's cache
+     bool
+     VerifyReceivedData(const Data& keyData);
+
+     //records the verdict on the Data waiting for its key (evil => build the pursuit Exclude)
+     void
+     ApplyVerdict(bool good);
+
+     //CoalesceKeyFetches: the node's KeyFetchCoalescer verified data (ignored unless it is still the
+     //Data I am waiting on)
+     void
+     OnVerdict(shared_ptr<const Data> data, bool good, bool cached);
+
+     //NoticePrefix: tells the other consumers which Data under my prefix is bad, in a signed Interest
+     //named <NoticePrefix>/<full name of the bad Data>
+     void
+     PublishNotice(const Data& badData);
+
+     //true when the notice carries a key signature by NoticeIdentity that checks out against its key
+     //(a DigestSha256 notice is never accepted)
+     bool
+     VerifyNotice(const Interest& notice);
+
+     //excludes the bad Data's next component (its extra component, or its implicit digest when the
+     //names are the same) in the pursuit Interests
+     void
+     ExcludeBadData(const Data& data);
+
+     //AnomalyPrefilter: takes Data that looks like the verified Data so far without verifying it (no key fetch);
+     //returns false when it has to go through verification
+     bool
+     PrefilterTrusts(const Data& data, uint32_t seq, const AnomalyPrefilter::Features& features);
+
+     //hands the Data of m_originalSequenceNumber to the application (TimeToFirstByte)
+     void
+     Deliver();
+
+     //leaves verification mode with the verdict on the last data (after the simulated verification cost)
+     void
+     FinishVerification();
+
   protected:
     //have a lot of fields that are inherited from consumer
     //m_rand = nonce generator (a pointer to it)
@@ -71,6 +145,8 @@ class SecurityToyClientApp : public Consumer
      uint32_t m_keyRequestInterestSeq;
      double m_waitTime; //time from a packet being verified to sending the next interest
      double m_delayStartTime; //time to wait before sending first packet
+     double m_startJitter; //max random extra wait (in seconds) added on top of the delay start
+     Ptr<UniformRandomVariable> m_jitterRand; //generator for the start jitter
      uint32_t m_originalNonce;//the original nonce of the Interest that got the bad packet back
      uint32_t m_originalSequenceNumber; //original sequence number of the packet I sent
 
@@ -80,7 +156,80 @@ class SecurityToyClientApp : public Consumer
 
      Name m_keyName; //name of the verification packet that producer makes
      shared_ptr<const Data> m_evilPacket; //data of the evil packet...
-     shared_ptr<Name> m_originalInterestName; //the original name of the packet sent out
+     Name m_originalInterestName; //the original name of the packet sent out (rebuilt from m_interestName per send)
+     Exclude m_pursuitExclude; //exclude filter for the evil packet I am pursuing past
+     Exclude m_noExclude; //empty filter to reset recycled Interests with
+     time::milliseconds m_interestLifetimeMs; //m_interestLifeTime, converted once on start
+
+     std::vector<shared_ptr<Interest>> m_interestPool; //Interests I can refill once the forwarder lets go of them
+     uint32_t m_interestPoolSize;
+     TracedValue<uint64_t> m_interestsAllocated;
+     TracedValue<uint64_t> m_interestsReused;
+
+     EventRing m_eventLog; //per-packet diagnostics (see event-ring-logger.hpp)
+
+     bool m_verifySignatures; //check real signatures instead of guessing evil data from its size
+     shared_ptr<const Data> m_receivedData; //data waiting for its key (VerifySignatures only)
+     Ptr<VerificationCache> m_verificationCache; //shared by the apps on my node
+
+     bool m_simulateCryptoCost; //spend the calibrated verification cost in simulated time
+     std::string m_keyAlgorithm; //what the producer signs with (for the cost model)
+     bool m_expectDigest; //KeyAlgorithm is sha256: only then is a DigestSha256 Data acceptable
+     uint32_t m_keySize;
+     Time m_verifyDelay;
+     EventId m_verifyEvent; //pending FinishVerification
+
+     bool m_coalesceKeyFetches; //share key fetches and verify in batches with the node's other consumers
+     Ptr<KeyFetchCoalescer> m_keyCoalescer;
+     bool m_awaitingVerdict; //my Data is parked in the coalescer
+     Time m_receivedAt; //when the Data waiting for verification came in
+     TracedValue<uint64_t> m_keyInterests; //key Interests I sent
+     Time m_keyRequestedAt; //first key Interest for the Data waiting for its key (0 = none out)
+     //data seq, time from my first key Interest to the key Data
+     TracedCallback<Ptr<App>, uint32_t, Time> m_keyFetchLatency;
+     TracedValue<uint64_t> m_dataVerified; //Data I got a verdict on
+     //data seq, time from the Data arriving to its verdict
+     TracedCallback<Ptr<App>, uint32_t, Time> m_verificationLatency;
+
+     bool m_useBadDataFilter; //drop Data the node already found bad without fetching the key
+     Ptr<BadDataFilter> m_badDataFilter;
+     TracedValue<uint64_t> m_knownBadDropped; //Data dropped by the filter
+
+     Name m_noticePrefix; //empty = no poisoning notices
+     Name m_noticeIdentity;
+     std::string m_noticeAlgorithm;
+     ::ndn::security::SigningInfo m_noticeSigningInfo;
+     std::map<uint32_t, name::Component> m_noticedBad; //seq => component to exclude from the first Interest
+     TracedValue<uint64_t> m_noticesSent;
+     TracedValue<uint64_t> m_noticesReceived;
+     TracedValue<uint64_t> m_noticesRejected; //notices for my prefix with a bad signature
+     std::unique_ptr< ::ndn::security::v1::PublicKey> m_noticeKey; //trusted key of NoticeIdentity
+
+     bool m_useAnomalyPrefilter; //skip verification for Data that does not look unusual
+     double m_prefilterThreshold; //score at which Data counts as suspicious
+     uint32_t m_prefilterWarmup; //verified Data needed before anything is skipped
+     AnomalyPrefilter m_prefilter;
+     AnomalyPrefilter::Features m_pendingFeatures; //of the Data waiting for its verdict
+     //judged against the payload size marker (GoodDataSize), the ground truth of the toy scenarios
+     TracedValue<uint64_t> m_prefilterTrusted; //accepted unverified = key fetches saved
+     TracedValue<uint64_t> m_prefilterSuspicious; //sent to verification after warmup
+     TracedValue<uint64_t> m_prefilterMissed; //trusted but evil
+     TracedValue<uint64_t> m_prefilterFalseAlarms; //suspicious but good
+     bool m_reportStats;
+
+     bool m_speculative; //deliver Data on arrival and roll it back if verification fails
+     Time m_requestedAt; //first Interest for m_originalSequenceNumber
+     Time m_deliveredAt;
+     bool m_deliveredUnverified; //the Data waiting for its verdict is already in use
+     //data seq, time from its first Interest to handing it to the application
+     TracedCallback<Ptr<App>, uint32_t, Time> m_timeToFirstByte;
+     //data seq, time from its first Interest to its verdict
+     TracedCallback<Ptr<App>, uint32_t, Time> m_timeToVerified;
+     //data seq, time the bad Data was in use
+     TracedCallback<Ptr<App>, uint32_t, Time> m_rollback;
+     TracedValue<uint64_t> m_rollbacks;
+
+     int32_t m_metricsSlot; //my counters in the MetricsSampler (-1 = not sampled)
    
 };
 
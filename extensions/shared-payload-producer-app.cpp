@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "shared-payload-producer-app.hpp"
+#include "shared-payload.hpp"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "helper/ndn-fib-helper.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.SharedPayloadProducerApp");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(SharedPayloadProducerApp);
+
+TypeId
+SharedPayloadProducerApp::GetTypeId(void)
+{
+   static TypeId tid = TypeId("ns3::ndn::SharedPayloadProducerApp")
+    .SetGroupName("Ndn")
+    .SetParent<App>()
+    .AddConstructor<SharedPayloadProducerApp>()
+    .AddAttribute("Prefix", "Prefix, for which producer has the data", StringValue("/"),
+                  MakeNameAccessor(&SharedPayloadProducerApp::m_prefix), MakeNameChecker())
+    .AddAttribute("Postfix", "Postfix that is added to the output data (e.g., for adding producer-uniqueness)",
+                  StringValue("/"), MakeNameAccessor(&SharedPayloadProducerApp::m_postfix), MakeNameChecker())
+    .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
+                  MakeUintegerAccessor(&SharedPayloadProducerApp::m_virtualPayloadSize),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
+                  TimeValue(Seconds(0)), MakeTimeAccessor(&SharedPayloadProducerApp::m_freshness),
+                  MakeTimeChecker())
+    .AddAttribute("Signature", "Fake signature, 0 valid signature (default), other values application-specific",
+                  UintegerValue(0), MakeUintegerAccessor(&SharedPayloadProducerApp::m_signature),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("KeyLocator", "Name to be used for key locator.  If root, then key locator is not used",
+                  NameValue(), MakeNameAccessor(&SharedPayloadProducerApp::m_keyLocator), MakeNameChecker());
+
+   return tid;
+}
+
+SharedPayloadProducerApp::SharedPayloadProducerApp()
+{
+   NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+SharedPayloadProducerApp::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  Name dataName(interest->getName());
+
+  auto data = make_shared<Data>();
+  data->setName(dataName);
+  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+  data->setContent(SharedPayload::Get(m_virtualPayloadSize));
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
+  }
+
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+
+  data->setSignature(signature);
+
+  // to create real wire encoding
+  data->wireEncode();
+
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+}
+
+void
+SharedPayloadProducerApp::StartApplication()
+{
+   NS_LOG_FUNCTION_NOARGS();
+   App::StartApplication();
+   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+}
+
+void
+SharedPayloadProducerApp::StopApplication()
+{
+   NS_LOG_FUNCTION_NOARGS();
+   App::StopApplication();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef SHAREDPAYLOADPRODUCERAPP_H
+#define SHAREDPAYLOADPRODUCERAPP_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/integer.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+
+namespace ns3{
+namespace ndn{
+
+//Same producer as ns3::ndn::Producer (same attributes, same Data on the wire), except the payload of
+//every Data comes from SharedPayload instead of a new zeroed buffer per reply.
+class SharedPayloadProducerApp : public App
+{
+   public:
+     static TypeId
+     GetTypeId();
+
+     SharedPayloadProducerApp();
+
+     virtual void
+     OnInterest(shared_ptr<const Interest> interest);
+
+   protected:
+     virtual void
+     StartApplication();
+
+     virtual void
+     StopApplication();
+
+   private:
+     Name m_prefix;
+     Name m_postfix;
+     uint32_t m_virtualPayloadSize;
+     Time m_freshness;
+
+     uint32_t m_signature;
+     Name m_keyLocator;
+};
+
+}//namespace ndn
+
+}//namespace ns3
+
+#endif
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "shared-payload.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+SharedPayload::BlockMap&
+SharedPayload::GetBlocks()
+{
+   static BlockMap blocks;
+   return blocks;
+}
+
+ConstBufferPtr
+SharedPayload::Get(uint32_t size, uint8_t fill)
+{
+   BlockMap& blocks = GetBlocks();
+   auto key = std::make_pair(size, fill);
+
+   auto block = blocks.find(key);
+   if(block != blocks.end())
+   {
+     return block->second;
+   }
+
+   auto buffer = make_shared< ::ndn::Buffer>(size);
+   std::fill(buffer->begin(), buffer->end(), fill);
+   blocks[key] = buffer;
+   return buffer;
+}
+
+size_t
+SharedPayload::GetBlockCount()
+{
+   return GetBlocks().size();
+}
+
+} // namespace ndn
+} // namespace ns3
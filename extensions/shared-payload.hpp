@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef SHAREDPAYLOAD_H
+#define SHAREDPAYLOAD_H
+
+#include "ns3/ndnSIM-module.h"
+
+#include <map>
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+
+//Hands out one read-only, reference counted payload buffer per (size, fill byte) pair, so producers
+//don't allocate and zero a fresh PayloadSize buffer for every Data they send.
+//
+//Data::setContent keeps a reference to the buffer until the Data is wire encoded (the encoding copies
+//the bytes), so the saving is the per-reply allocation + memset, not the wire copy.
+class SharedPayload
+{
+  public:
+     static ConstBufferPtr
+     Get(uint32_t size, uint8_t fill = 0);
+
+     //number of distinct payload blocks handed out so far
+     static size_t
+     GetBlockCount();
+
+  private:
+     typedef std::map<std::pair<uint32_t, uint8_t>, ConstBufferPtr> BlockMap;
+
+     static BlockMap&
+     GetBlocks();
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
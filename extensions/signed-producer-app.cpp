@@ -0,0 +1,346 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "signed-producer-app.hpp"
+#include "shared-payload.hpp"
+#include "crypto-cost-model.hpp"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "helper/ndn-fib-helper.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SignedProducerApp");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(SignedProducerApp);
+
+TypeId
+SignedProducerApp::GetTypeId(void)
+{
+   static TypeId tid = TypeId("ns3::ndn::SignedProducerApp")
+    .SetGroupName("Ndn")
+    .SetParent<App>()
+    .AddConstructor<SignedProducerApp>()
+    .AddAttribute("Prefix", "Prefix, for which producer has the data", StringValue("/"),
+                  MakeNameAccessor(&SignedProducerApp::m_prefix), MakeNameChecker())
+    .AddAttribute("PayloadSize", "Payload size for Content packets", UintegerValue(1024),
+                  MakeUintegerAccessor(&SignedProducerApp::m_payloadSize),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
+                  TimeValue(Seconds(0)), MakeTimeAccessor(&SignedProducerApp::m_freshness),
+                  MakeTimeChecker())
+    .AddAttribute("Identity", "Identity that signs the Data", StringValue("/prefix/key"),
+                  MakeNameAccessor(&SignedProducerApp::m_identity), MakeNameChecker())
+    .AddAttribute("Algorithm", "Signing algorithm: rsa, ecdsa or sha256", StringValue("ecdsa"),
+                  MakeStringAccessor(&SignedProducerApp::m_algorithmName), MakeStringChecker())
+    .AddAttribute("KeySize", "Key size in bits (0 = 2048 for rsa, 256 for ecdsa)", UintegerValue(0),
+                  MakeUintegerAccessor(&SignedProducerApp::m_keySize), MakeUintegerChecker<uint32_t>())
+    .AddAttribute("CacheSize", "Names whose signed Data is kept for repeated Interests (0 = sign every time)",
+                  UintegerValue(100000), MakeUintegerAccessor(&SignedProducerApp::m_cacheSize),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("ServeKey", "Answer with the identity's public key instead of the payload (signer mode)",
+                  BooleanValue(false), MakeBooleanAccessor(&SignedProducerApp::m_serveKey),
+                  MakeBooleanChecker())
+    .AddAttribute("ReportStats", "Print signatures per second and the cache hit rate when the app goes away",
+                  BooleanValue(false), MakeBooleanAccessor(&SignedProducerApp::m_reportStats),
+                  MakeBooleanChecker())
+    .AddAttribute("PreSignMaxSeq", "Pre-sign <Prefix>/<seq> for seq below this before the run (0 = off)",
+                  UintegerValue(0), MakeUintegerAccessor(&SignedProducerApp::m_preSignMaxSeq),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("PreSignThreads", "Threads used for pre-signing (0 = one per core)",
+                  UintegerValue(0), MakeUintegerAccessor(&SignedProducerApp::m_preSignThreads),
+                  MakeUintegerChecker<uint32_t>())
+    .AddAttribute("SimulateCryptoCost", "Delay Data that has to be signed by the calibrated signing cost",
+                  BooleanValue(false), MakeBooleanAccessor(&SignedProducerApp::m_simulateCryptoCost),
+                  MakeBooleanChecker())
+    .AddTraceSource("Signatures", "Number of Data packets signed",
+                    MakeTraceSourceAccessor(&SignedProducerApp::m_signatures),
+                    "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource("CacheHits", "Number of Interests answered with already signed Data",
+                    MakeTraceSourceAccessor(&SignedProducerApp::m_cacheHits),
+                    "ns3::TracedValueCallback::Uint64")
+    .AddTraceSource("PreSignedHits", "Number of Interests answered with pre-signed Data",
+                    MakeTraceSourceAccessor(&SignedProducerApp::m_preSignedHits),
+                    "ns3::TracedValueCallback::Uint64");
+
+   return tid;
+}
+
+SignedProducerApp::SignedProducerApp()
+  : m_payloadSize(1024)
+  , m_keySize(0)
+  , m_cacheSize(100000)
+  , m_serveKey(false)
+  , m_reportStats(false)
+  , m_signatures(0)
+  , m_cacheHits(0)
+  , m_signingNs(0)
+  , m_preSignMaxSeq(0)
+  , m_preSignThreads(0)
+  , m_preSignedHits(0)
+  , m_simulateCryptoCost(false)
+{
+   NS_LOG_FUNCTION_NOARGS();
+}
+
+shared_ptr<Data>
+SignedProducerApp::MakeSignedData(const Name& dataName)
+{
+  auto data = make_shared<Data>();
+  data->setName(dataName);
+  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+
+  ConstBufferPtr key = m_serveKey ? SigningKeyChain::Get().GetPublicKeyBits(m_identity) : ConstBufferPtr();
+  if(key && !key->empty())
+  {
+    data->setContent(key);
+  }
+  else
+  {
+    data->setContent(SharedPayload::Get(m_payloadSize));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  SigningKeyChain::Get().Sign(*data, m_signingInfo); //also wire encodes
+  m_signingNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  m_signatures++;
+
+  return data;
+}
+
+void
+SignedProducerApp::PreSignAll()
+{
+   for(NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++)
+   {
+     for(uint32_t i = 0; i < (*node)->GetNApplications(); i++)
+     {
+       Ptr<SignedProducerApp> app = DynamicCast<SignedProducerApp>((*node)->GetApplication(i));
+       if(app != 0)
+       {
+         app->PreSign();
+       }
+     }
+   }
+}
+
+void
+SignedProducerApp::PreSign()
+{
+   if(m_preSignMaxSeq == 0 || m_serveKey || m_arena)
+     return;
+
+   m_signingInfo = SigningKeyChain::Get().Prepare(m_identity, SigningKeyChain::ParseAlgorithm(m_algorithmName),
+                                                  m_keySize);
+
+   uint32_t threads = m_preSignThreads;
+   if(threads == 0)
+   {
+     threads = std::max(1u, std::thread::hardware_concurrency());
+   }
+   threads = std::min(threads, m_preSignMaxSeq);
+
+   //everything the workers share is read only from here on (the prefix is encoded now, not lazily in a worker)
+   ConstBufferPtr payload = SharedPayload::Get(m_payloadSize);
+   m_prefix.wireEncode();
+   ::ndn::time::milliseconds freshness(m_freshness.GetMilliSeconds());
+
+   std::vector<Block> wires(m_preSignMaxSeq);
+   auto start = std::chrono::steady_clock::now();
+
+   //thread t signs seq t, t + threads, ... with its own KeyChain
+   std::vector<std::thread> workers;
+   for(uint32_t t = 0; t < threads; t++)
+   {
+     workers.push_back(std::thread([this, t, threads, &wires, &payload, freshness] {
+       std::unique_ptr< ::ndn::KeyChain> keyChain = SigningKeyChain::Get().CreateWorkerKeyChain();
+       for(uint32_t seq = t; seq < m_preSignMaxSeq; seq += threads)
+       {
+         Name dataName(m_prefix);
+         dataName.appendSequenceNumber(seq);
+
+         Data data(dataName);
+         data.setFreshnessPeriod(freshness);
+         data.setContent(payload);
+         keyChain->sign(data, m_signingInfo);
+         wires[seq] = data.wireEncode();
+       }
+     }));
+   }
+   for(auto& worker : workers)
+   {
+     worker.join();
+   }
+
+   //pack the encodings into one arena and drop the per-Data buffers
+   m_arenaOffsets.resize(m_preSignMaxSeq + 1);
+   m_arenaOffsets[0] = 0;
+   for(uint32_t seq = 0; seq < m_preSignMaxSeq; seq++)
+   {
+     m_arenaOffsets[seq + 1] = m_arenaOffsets[seq] + wires[seq].size();
+   }
+
+   auto arena = make_shared< ::ndn::Buffer>(m_arenaOffsets.back());
+   for(uint32_t seq = 0; seq < m_preSignMaxSeq; seq++)
+   {
+     std::memcpy(arena->buf() + m_arenaOffsets[seq], wires[seq].wire(), wires[seq].size());
+   }
+   m_arena = arena;
+   m_preSignedServed.assign(m_preSignMaxSeq, false);
+
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   NS_LOG_INFO("Pre-signed " << m_preSignMaxSeq << " Data for " << m_prefix << " on " << threads
+               << " threads in " << seconds << "s (" << m_arena->size() << " bytes)");
+   if(m_reportStats)
+   {
+     std::cout << "SignedProducerApp " << m_prefix << ": pre-signed " << m_preSignMaxSeq << " Data on "
+               << threads << " threads in " << seconds << "s, " << m_preSignMaxSeq / seconds
+               << " signatures-per-s, arena=" << m_arena->size() << " bytes" << std::endl;
+   }
+}
+
+shared_ptr<const Data>
+SignedProducerApp::LookupPreSigned(const Name& dataName, bool& firstServe)
+{
+  if(!m_arena || dataName.size() != m_prefix.size() + 1 || !m_prefix.isPrefixOf(dataName)
+     || !dataName.get(-1).isSequenceNumber())
+    return nullptr;
+
+  uint64_t seq = dataName.get(-1).toSequenceNumber();
+  if(seq >= m_preSignMaxSeq)
+    return nullptr;
+
+  firstServe = !m_preSignedServed[seq];
+  m_preSignedServed[seq] = true;
+
+  //the Block shares the arena, so nothing is copied here
+  Block wire(m_arena, m_arena->begin() + m_arenaOffsets[seq], m_arena->begin() + m_arenaOffsets[seq + 1]);
+  return make_shared<Data>(wire);
+}
+
+void
+SignedProducerApp::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  bool signedNow = false; //did the modelled producer have to sign this one
+  shared_ptr<const Data> data = LookupPreSigned(interest->getName(), signedNow);
+  auto cached = data ? m_signedCache.end() : m_signedCache.find(interest->getName());
+
+  if(data)
+  {
+    m_preSignedHits++;
+  }
+  else if(cached != m_signedCache.end())
+  {
+    data = cached->second;
+    m_cacheHits++;
+  }
+  else
+  {
+    data = MakeSignedData(interest->getName());
+    signedNow = true;
+    if(m_signedCache.size() < m_cacheSize)
+    {
+      m_signedCache[interest->getName()] = data;
+    }
+  }
+
+  if(m_simulateCryptoCost && signedNow)
+  {
+    //one signature at a time: this one starts when the previous one is done
+    m_cpuFreeAt = std::max(m_cpuFreeAt, Simulator::Now()) + m_signDelay;
+    Simulator::Schedule(m_cpuFreeAt - Simulator::Now(), &SignedProducerApp::SendData, this, data);
+    return;
+  }
+
+  SendData(data);
+}
+
+void
+SignedProducerApp::SendData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+}
+
+void
+SignedProducerApp::StartApplication()
+{
+   NS_LOG_FUNCTION_NOARGS();
+   App::StartApplication();
+   m_signingInfo = SigningKeyChain::Get().Prepare(m_identity, SigningKeyChain::ParseAlgorithm(m_algorithmName),
+                                                  m_keySize);
+   if(m_simulateCryptoCost)
+   {
+     m_signDelay = CryptoCostModel::GetSignDelay(SigningKeyChain::ParseAlgorithm(m_algorithmName), m_keySize);
+   }
+   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+}
+
+void
+SignedProducerApp::StopApplication()
+{
+   NS_LOG_FUNCTION_NOARGS();
+   App::StopApplication();
+}
+
+void
+SignedProducerApp::DoDispose()
+{
+   if(m_reportStats)
+   {
+     uint64_t requests = m_signatures + m_cacheHits;
+     double signingSeconds = m_signingNs / 1e9;
+     std::cout << "SignedProducerApp node(" << GetNode()->GetId() << ") " << m_prefix
+               << ": " << m_algorithmName << " signatures=" << m_signatures
+               << " signatures-per-s=" << (signingSeconds > 0 ? m_signatures / signingSeconds : 0)
+               << " cache-hits=" << m_cacheHits
+               << " hit-rate=" << (requests > 0 ? double(m_cacheHits) / requests : 0)
+               << " pre-signed-hits=" << m_preSignedHits << std::endl;
+   }
+
+   m_signedCache.clear();
+   m_arena.reset();
+   App::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
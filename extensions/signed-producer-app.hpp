@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef SIGNEDPRODUCERAPP_H
+#define SIGNEDPRODUCERAPP_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/integer.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/traced-value.h"
+
+#include "ns3/ndnSIM/apps/ndn-app.hpp"
+#include "signing-key-chain.hpp"
+
+#include <map>
+#include <vector>
+
+namespace ns3{
+namespace ndn{
+
+//Producer that really signs its Data (with SigningKeyChain) instead of sending a dummy signature.
+//
+//Signing is done once per name: the signed Data is kept and handed out again for repeated or
+//retransmitted Interests, up to CacheSize names.
+//PreSignMaxSeq > 0 signs the Data for <Prefix>/<seq 0..PreSignMaxSeq-1> up front on all cores (see PreSignAll)
+//and keeps their wire encodings back to back in one arena, so the event loop only looks them up.
+//SimulateCryptoCost delays each Data the (modelled) producer has to sign by the CryptoCostModel cost of
+//the algorithm, one signature at a time, so a busy producer queues up. Data signed before is sent at once.
+//With ServeKey set the content is the identity's public key instead of the payload, which turns the
+//app into the signer the consumers fetch their key from (use the producer's Identity for both).
+class SignedProducerApp : public App
+{
+   public:
+     static TypeId
+     GetTypeId();
+
+     SignedProducerApp();
+
+     virtual void
+     OnInterest(shared_ptr<const Interest> interest);
+
+     //pre-signs the PreSignMaxSeq range of every installed SignedProducerApp (call before Simulator::Run,
+     //it takes wall-clock time but no simulated time)
+     static void
+     PreSignAll();
+
+     //pre-signs my own range across PreSignThreads threads
+     void
+     PreSign();
+
+   protected:
+     virtual void
+     StartApplication();
+
+     virtual void
+     StopApplication();
+
+     virtual void
+     DoDispose();
+
+     //builds and signs the Data for a name (no cache lookup)
+     shared_ptr<Data>
+     MakeSignedData(const Name& dataName);
+
+     //the pre-signed Data for a name, or nullptr when it is not in the pre-signed range
+     //firstServe tells whether it is handed out for the first time
+     shared_ptr<const Data>
+     LookupPreSigned(const Name& dataName, bool& firstServe);
+
+     //hands the Data to my face (now, or once the simulated signature is done)
+     void
+     SendData(shared_ptr<const Data> data);
+
+   protected:
+     Name m_prefix;
+     uint32_t m_payloadSize;
+     Time m_freshness;
+     Name m_identity; //who signs (and whose key ServeKey hands out)
+     std::string m_algorithmName;
+     uint32_t m_keySize;
+     uint32_t m_cacheSize; //max names whose signed Data I keep
+     bool m_serveKey;
+     bool m_reportStats;
+
+     ::ndn::security::SigningInfo m_signingInfo;
+     std::map<Name, shared_ptr<const Data>> m_signedCache;
+
+     TracedValue<uint64_t> m_signatures; //Data signed so far
+     TracedValue<uint64_t> m_cacheHits; //Interests answered from the signed cache
+     int64_t m_signingNs; //wall-clock time spent signing
+
+     uint32_t m_preSignMaxSeq; //0 = sign on demand only
+     uint32_t m_preSignThreads; //0 = one per core
+     ConstBufferPtr m_arena; //wire encodings of the pre-signed Data, in sequence order
+     std::vector<size_t> m_arenaOffsets; //Data for seq i is [m_arenaOffsets[i], m_arenaOffsets[i + 1])
+     std::vector<bool> m_preSignedServed; //pre-signed Data already handed out once (= signed, for the model)
+     TracedValue<uint64_t> m_preSignedHits; //Interests answered from the arena
+
+     bool m_simulateCryptoCost;
+     Time m_signDelay; //simulated cost of one signature (CryptoCostModel)
+     Time m_cpuFreeAt; //when the signature in progress is done
+};
+
+}//namespace ndn
+
+}//namespace ns3
+
+#endif
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "signing-key-chain.hpp"
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+
+#include <boost/filesystem.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SigningKeyChain");
+
+namespace ns3 {
+namespace ndn {
+
+SigningKeyChain&
+SigningKeyChain::Get()
+{
+   static SigningKeyChain keyChain;
+   return keyChain;
+}
+
+SigningKeyChain::SigningKeyChain()
+{
+   boost::filesystem::path directory = boost::filesystem::temp_directory_path() /
+                                       boost::filesystem::unique_path("ndnsim-signer-%%%%-%%%%-%%%%");
+   boost::filesystem::create_directories(directory);
+   m_directory = directory.string();
+
+   m_keyChain.reset(new ::ndn::KeyChain(GetPibLocator(), GetTpmLocator(), true));
+   NS_LOG_DEBUG("KeyChain in " << m_directory);
+}
+
+std::string
+SigningKeyChain::GetPibLocator() const
+{
+   return "pib-sqlite3:" + m_directory;
+}
+
+std::string
+SigningKeyChain::GetTpmLocator() const
+{
+   return "tpm-file:" + m_directory;
+}
+
+std::unique_ptr< ::ndn::KeyChain>
+SigningKeyChain::CreateWorkerKeyChain() const
+{
+   return std::unique_ptr< ::ndn::KeyChain>(new ::ndn::KeyChain(GetPibLocator(), GetTpmLocator()));
+}
+
+SigningKeyChain::~SigningKeyChain()
+{
+   m_keyChain.reset();
+   boost::system::error_code error;
+   boost::filesystem::remove_all(m_directory, error);
+}
+
+SigningKeyChain::Algorithm
+SigningKeyChain::ParseAlgorithm(const std::string& algorithm)
+{
+   if(algorithm == "rsa")
+     return RSA;
+   if(algorithm == "ecdsa")
+     return ECDSA;
+   if(algorithm == "sha256")
+     return SHA256;
+
+   NS_FATAL_ERROR("Unknown signing algorithm " << algorithm << " (use rsa, ecdsa or sha256)");
+   return SHA256;
+}
+
+const char*
+SigningKeyChain::GetAlgorithmName(Algorithm algorithm)
+{
+   switch(algorithm)
+   {
+     case RSA:
+       return "rsa";
+     case ECDSA:
+       return "ecdsa";
+     default:
+       return "sha256";
+   }
+}
+
+::ndn::security::SigningInfo
+SigningKeyChain::Prepare(const Name& identity, Algorithm algorithm, uint32_t keySize)
+{
+   auto prepared = m_identities.find(identity);
+   if(prepared != m_identities.end())
+   {
+     if(prepared->second.algorithm != algorithm)
+     {
+       NS_LOG_WARN("Identity " << identity << " already uses " << GetAlgorithmName(prepared->second.algorithm)
+                   << ", ignoring " << GetAlgorithmName(algorithm));
+     }
+     return prepared->second.signingInfo;
+   }
+
+   PreparedIdentity entry;
+   entry.algorithm = algorithm;
+   entry.publicKeyBits = make_shared< ::ndn::Buffer>();
+
+   switch(algorithm)
+   {
+     case RSA:
+       m_keyChain->createIdentity(identity, ::ndn::RsaKeyParams(keySize > 0 ? keySize : 2048));
+       break;
+     case ECDSA:
+       m_keyChain->createIdentity(identity, ::ndn::EcdsaKeyParams(keySize > 0 ? keySize : 256));
+       break;
+     case SHA256:
+       break;
+   }
+
+   if(algorithm == SHA256)
+   {
+     entry.signingInfo = ::ndn::security::signingWithSha256();
+   }
+   else
+   {
+     entry.signingInfo = ::ndn::security::signingByIdentity(identity);
+     Name keyName = m_keyChain->getDefaultKeyNameForIdentity(identity);
+     entry.publicKeyBits = make_shared< ::ndn::Buffer>(m_keyChain->getPublicKey(keyName)->get());
+   }
+
+   NS_LOG_INFO("Prepared " << GetAlgorithmName(algorithm) << " identity " << identity);
+   m_identities[identity] = entry;
+   return entry.signingInfo;
+}
+
+void
+SigningKeyChain::Sign(Data& data, const ::ndn::security::SigningInfo& info)
+{
+   m_keyChain->sign(data, info);
+}
+
+void
+SigningKeyChain::Sign(Interest& interest, const ::ndn::security::SigningInfo& info)
+{
+   m_keyChain->sign(interest, info);
+}
+
+ConstBufferPtr
+SigningKeyChain::GetPublicKeyBits(const Name& identity)
+{
+   auto prepared = m_identities.find(identity);
+   if(prepared == m_identities.end())
+   {
+     return make_shared< ::ndn::Buffer>();
+   }
+   return prepared->second.publicKeyBits;
+}
+
+::ndn::KeyChain&
+SigningKeyChain::GetKeyChain()
+{
+   return *m_keyChain;
+}
+
+} // namespace ndn
+} // namespace ns3
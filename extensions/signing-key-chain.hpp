@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef SIGNINGKEYCHAIN_H
+#define SIGNINGKEYCHAIN_H
+
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+//Process-wide KeyChain for the apps that really sign (ndnSIM's own KeyChain only makes dummy signatures).
+//
+//All apps in the process share it, so a producer and a signer that name the same identity end up with the
+//same key pair: the producer signs with it and the signer serves its public key. The PIB and TPM live in a
+//scratch directory that is removed again when the process exits.
+//
+//Algorithms: "rsa" and "ecdsa" sign with the identity's key pair. "sha256" is a plain DigestSha256 (no key).
+//The KeyChain of this ndn-cxx version has no HMAC signing, so "sha256" is the cheap keyless option.
+class SigningKeyChain
+{
+  public:
+     enum Algorithm
+     {
+       RSA,
+       ECDSA,
+       SHA256
+     };
+
+     static SigningKeyChain&
+     Get();
+
+     //"rsa", "ecdsa" or "sha256" (fatal error otherwise)
+     static Algorithm
+     ParseAlgorithm(const std::string& algorithm);
+
+     static const char*
+     GetAlgorithmName(Algorithm algorithm);
+
+     //creates the identity's key pair the first time it is asked for (keySize 0 = algorithm default)
+     //and returns how to sign with it
+     ::ndn::security::SigningInfo
+     Prepare(const Name& identity, Algorithm algorithm, uint32_t keySize);
+
+     void
+     Sign(Data& data, const ::ndn::security::SigningInfo& info);
+
+     //signed Interest: appends the signature info and value components to the name
+     void
+     Sign(Interest& interest, const ::ndn::security::SigningInfo& info);
+
+     //DER encoded public key of a prepared identity (empty for sha256)
+     ConstBufferPtr
+     GetPublicKeyBits(const Name& identity);
+
+     ::ndn::KeyChain&
+     GetKeyChain();
+
+     //a separate KeyChain on the same PIB/TPM, for signing from another thread
+     //(KeyChain itself is not thread safe, the keys on disk can be shared)
+     std::unique_ptr< ::ndn::KeyChain>
+     CreateWorkerKeyChain() const;
+
+     ~SigningKeyChain();
+
+  private:
+     SigningKeyChain();
+
+     std::string
+     GetPibLocator() const;
+
+     std::string
+     GetTpmLocator() const;
+
+     struct PreparedIdentity
+     {
+       Algorithm algorithm;
+       ::ndn::security::SigningInfo signingInfo;
+       ConstBufferPtr publicKeyBits;
+     };
+
+     std::string m_directory; //scratch PIB/TPM directory
+     std::unique_ptr< ::ndn::KeyChain> m_keyChain;
+     std::map<Name, PreparedIdentity> m_identities;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "trace-shards.hpp"
+#include "scenario-registry.hpp"
+#include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TraceShards");
+
+namespace ns3 {
+namespace ndn {
+
+static GlobalValue g_traceShardDir("TraceShardDir",
+                                   "Directory to write every trace as a per-run shard with an index "
+                                   "(empty = write the traces where the scenario says)",
+                                   StringValue(""), MakeStringChecker());
+
+std::map<std::string, std::string> TraceShards::s_resolved;
+uint32_t TraceShards::s_run = 0;
+
+static ScenarioRegistry::ResetHook g_resetHook(&TraceShards::Reset);
+
+static bool
+MakeDirectory(const std::string& dir)
+{
+   return mkdir(dir.c_str(), 0777) == 0 || errno == EEXIST;
+}
+
+std::string
+TraceShards::Resolve(const std::string& path)
+{
+   StringValue dir;
+   g_traceShardDir.GetValue(dir);
+   if(dir.Get().empty() || path.empty())
+     return path;
+
+   auto resolved = s_resolved.find(path);
+   if(resolved != s_resolved.end())
+     return resolved->second;
+
+   //results/basic-app-delays-trace.txt => name basic-app-delays-trace, extension .txt
+   std::string file = path.substr(path.find_last_of('/') + 1);
+   size_t dot = file.find_last_of('.');
+   std::string name = dot == std::string::npos || dot == 0 ? file : file.substr(0, dot);
+   std::string extension = dot == std::string::npos || dot == 0 ? "" : file.substr(dot);
+
+   UintegerValue run;
+   GlobalValue::GetValueByName("RngRun", run);
+
+   std::ostringstream shard;
+   shard << dir.Get() << "/" << name << "/" << run.Get() << "-" << getpid() << "-" << s_run << extension;
+
+   if(!MakeDirectory(dir.Get()) || !MakeDirectory(dir.Get() + "/" + name))
+   {
+     NS_LOG_ERROR("Cannot create shard directory for " << shard.str() << ", writing " << path);
+     s_resolved[path] = path;
+     return path;
+   }
+
+   //the whole line in one write: O_APPEND puts it at the end of the index in one piece
+   std::ostringstream line;
+   line << shard.str() << " " << run.Get() << " " << getpid() << " " << s_run << "\n";
+   std::string index = dir.Get() + "/" + name + ".index";
+   int fd = open(index.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0666);
+   if(fd < 0 || write(fd, line.str().data(), line.str().size()) != static_cast<ssize_t>(line.str().size()))
+   {
+     NS_LOG_ERROR("Cannot append to shard index " << index);
+   }
+   if(fd >= 0)
+   {
+     close(fd);
+   }
+
+   s_resolved[path] = shard.str();
+   return shard.str();
+}
+
+void
+TraceShards::Reset()
+{
+   s_resolved.clear();
+   s_run++;
+}
+
+} // namespace ndn
+} // namespace ns3
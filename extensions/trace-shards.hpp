@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef TRACESHARDS_H
+#define TRACESHARDS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+//One trace file per run for sweeps that launch many runs of the same scenario at once:
+//  with --TraceShardDir=<dir> every trace path given to Resolve becomes a shard of its own,
+//  <dir>/<trace name>/<RngRun>-<pid>-<run><extension>, which only this process ever writes (<run> counts
+//  the scenarios the driver ran in this process, 0 for a scenario on its own), and one line
+//  "<shard path> <RngRun> <pid> <run>" is appended to <dir>/<trace name>.index (a single O_APPEND write, so
+//  concurrent runs never interleave their lines). tools/merge-shards.py merges the shards of an index
+//  back into one trace by time.
+//
+//Off (paths returned as they are) when TraceShardDir is empty, the default.
+class TraceShards
+{
+  public:
+     //where the trace meant for path should go in this run
+     static std::string
+     Resolve(const std::string& path);
+
+     //the next scenario in this process gets new shards (ScenarioRegistry reset hook)
+     static void
+     Reset();
+
+  private:
+     //trace path => shard, so a trace resolved twice in a run keeps its shard and one index line
+     static std::map<std::string, std::string> s_resolved;
+     static uint32_t s_run; //scenarios run in this process before this one
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "verification-cache.hpp"
+#include "handler-profiler.hpp"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/security/digest-sha256.hpp>
+
+#include <chrono>
+#include <iostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.VerificationCache");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(VerificationCache);
+
+TypeId
+VerificationCache::GetTypeId()
+{
+   static TypeId tid = TypeId("ns3::ndn::VerificationCache")
+     .SetGroupName("Ndn")
+     .SetParent<Object>()
+     .AddConstructor<VerificationCache>()
+     .AddAttribute("MaxEntries", "Max verification results kept per node (oldest digests dropped first)",
+                   UintegerValue(100000), MakeUintegerAccessor(&VerificationCache::m_maxEntries),
+                   MakeUintegerChecker<uint32_t>(1))
+     .AddAttribute("ReportStats", "Print verifications, cache hits and verification time when the node goes away",
+                   BooleanValue(false), MakeBooleanAccessor(&VerificationCache::m_reportStats),
+                   MakeBooleanChecker())
+     .AddTraceSource("Verifications", "Number of signatures really verified",
+                     MakeTraceSourceAccessor(&VerificationCache::m_verifications),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("Hits", "Number of checks answered from the cache",
+                     MakeTraceSourceAccessor(&VerificationCache::m_hits),
+                     "ns3::TracedValueCallback::Uint64")
+     .AddTraceSource("Failures", "Number of checks that failed",
+                     MakeTraceSourceAccessor(&VerificationCache::m_failures),
+                     "ns3::TracedValueCallback::Uint64");
+   return tid;
+}
+
+VerificationCache::VerificationCache()
+  : m_maxEntries(100000)
+  , m_reportStats(false)
+  , m_nodeId(0)
+  , m_verifications(0)
+  , m_hits(0)
+  , m_failures(0)
+  , m_verifyNs(0)
+{
+}
+
+Ptr<VerificationCache>
+VerificationCache::Get(Ptr<Node> node)
+{
+   Ptr<VerificationCache> cache = node->GetObject<VerificationCache>();
+   if(cache == 0)
+   {
+     cache = CreateObject<VerificationCache>();
+     cache->m_nodeId = node->GetId();
+     node->AggregateObject(cache);
+   }
+   return cache;
+}
+
+bool
+VerificationCache::Verify(const Data& data, const Block& keyContent, const Name& keyName, bool expectDigest,
+                          bool* wasCached)
+{
+   if(!IsAcceptable(data, keyName, expectDigest))
+   {
+     NS_LOG_DEBUG("node(" << m_nodeId << ") refused the signature of " << data.getName());
+     if(wasCached)
+     {
+       *wasCached = true;
+     }
+     m_failures++;
+     return false;
+   }
+
+   //getFullName hashes the wire encoding once and keeps the result in the Data
+   const name::Component& digest = data.getFullName().get(-1);
+
+   bool good;
+   auto cached = m_results.find(digest);
+   bool hit = (cached != m_results.end());
+   if(hit)
+   {
+     m_hits++;
+     good = cached->second;
+   }
+   else
+   {
+     good = VerifyUncached(data, keyContent);
+     if(m_results.size() >= m_maxEntries)
+     {
+       m_results.erase(m_order.front());
+       m_order.pop_front();
+     }
+     m_results[digest] = good;
+     m_order.push_back(digest);
+   }
+
+   if(wasCached)
+   {
+     *wasCached = hit;
+   }
+
+   if(!good)
+   {
+     m_failures++;
+   }
+   return good;
+}
+
+bool
+VerificationCache::IsAcceptable(const Data& data, const Name& keyName, bool expectDigest)
+{
+   const Signature& signature = data.getSignature();
+   if(signature.getType() == ::ndn::tlv::DigestSha256)
+     return expectDigest;
+
+   return !expectDigest && signature.hasKeyLocator()
+     && signature.getKeyLocator().getType() == ::ndn::KeyLocator::KeyLocator_Name
+     && keyName.isPrefixOf(signature.getKeyLocator().getName());
+}
+
+bool
+VerificationCache::VerifyUncached(const Data& data, const Block& keyContent)
+{
+   HandlerProfiler::Scope profile(HandlerProfiler::SIGNATURE_VERIFY);
+   auto start = std::chrono::steady_clock::now();
+
+   bool good = false;
+   if(data.getSignature().getType() == ::ndn::tlv::DigestSha256)
+   {
+     good = ::ndn::Validator::verifySignature(data, ::ndn::DigestSha256(data.getSignature()));
+   }
+   else
+   {
+     const ::ndn::security::v1::PublicKey* key = ParseKey(keyContent);
+     good = key != nullptr && ::ndn::Validator::verifySignature(data, *key);
+   }
+
+   m_verifyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start).count();
+   m_verifications++;
+
+   NS_LOG_DEBUG("node(" << m_nodeId << ") verified " << data.getName() << ": " << (good ? "good" : "bad"));
+   return good;
+}
+
+const ::ndn::security::v1::PublicKey*
+VerificationCache::ParseKey(const Block& keyContent)
+{
+   if(m_keyContent.hasWire() && m_keyContent == keyContent)
+     return m_key.get();
+
+   m_keyContent = keyContent;
+   m_key.reset();
+   try
+   {
+     m_key.reset(new ::ndn::security::v1::PublicKey(keyContent.value(), keyContent.value_size()));
+   }
+   catch(const ::ndn::security::v1::PublicKey::Error& e)
+   {
+     NS_LOG_WARN("node(" << m_nodeId << ") key content is not a public key: " << e.what());
+   }
+   return m_key.get();
+}
+
+int64_t
+VerificationCache::GetVerifyNs() const
+{
+   return m_verifyNs;
+}
+
+void
+VerificationCache::DoDispose()
+{
+   if(m_reportStats && (m_verifications > 0 || m_hits > 0))
+   {
+     std::cout << "VerificationCache node(" << m_nodeId << "): verifications=" << m_verifications
+               << " hits=" << m_hits << " failures=" << m_failures
+               << " verify-s=" << m_verifyNs / 1e9
+               << " us-per-verification=" << (m_verifications > 0 ? m_verifyNs / 1e3 / m_verifications : 0)
+               << std::endl;
+   }
+   m_results.clear();
+   m_order.clear();
+   m_key.reset();
+   Object::DoDispose();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#ifndef VERIFICATIONCACHE_H
+#define VERIFICATIONCACHE_H
+
+#include "ns3/ndnSIM-module.h"
+#include "ns3/object.h"
+#include "ns3/node.h"
+#include "ns3/traced-value.h"
+
+#include <ndn-cxx/security/v1/public-key.hpp>
+
+#include <deque>
+#include <map>
+#include <memory>
+
+namespace ns3 {
+namespace ndn {
+
+//Per-node cache of signature verification results, keyed by the Data's implicit SHA-256 digest.
+//
+//The same Data (a retransmission, or the copy another consumer on the node got from the CS) is only
+//verified once; later checks are a map lookup. Results assume one key per signer, which is what the
+//scenarios use. Aggregated to the node on first use, so all apps on a node share it.
+class VerificationCache : public Object
+{
+  public:
+     static TypeId
+     GetTypeId();
+
+     VerificationCache();
+
+     //the node's cache, created and aggregated the first time someone asks
+     static Ptr<VerificationCache>
+     Get(Ptr<Node> node);
+
+     //checks data's signature. With expectDigest (the producer signs with a sha256 digest) only a DigestSha256
+     //checked against the Data itself passes; otherwise only a key signature whose KeyLocator is under keyName,
+     //checked against the DER encoded public key in keyContent (a key that does not parse fails the check).
+     //wasCached (if given) tells whether the answer came without a real signature check (from the cache, or
+     //refused on the signature type or KeyLocator alone)
+     bool
+     Verify(const Data& data, const Block& keyContent, const Name& keyName, bool expectDigest,
+            bool* wasCached = 0);
+
+     //wall-clock time spent in real verifications so far
+     int64_t
+     GetVerifyNs() const;
+
+  protected:
+     virtual void
+     DoDispose();
+
+  private:
+     //the signature type and KeyLocator are what the consumer expects (a digest proves nothing about the
+     //signer, so it is only taken where the producer really uses one)
+     static bool
+     IsAcceptable(const Data& data, const Name& keyName, bool expectDigest);
+
+     bool
+     VerifyUncached(const Data& data, const Block& keyContent);
+
+     //the parsed key for keyContent (reparsed only when the key changes), nullptr if it does not parse
+     const ::ndn::security::v1::PublicKey*
+     ParseKey(const Block& keyContent);
+
+  private:
+     std::map<name::Component, bool> m_results; //implicit digest => signature good
+     std::deque<name::Component> m_order; //digests of m_results, oldest first (MaxEntries evicts from the front)
+     uint32_t m_maxEntries;
+     bool m_reportStats;
+     uint32_t m_nodeId;
+
+     TracedValue<uint64_t> m_verifications; //real signature checks done
+     TracedValue<uint64_t> m_hits; //checks answered from the cache
+     TracedValue<uint64_t> m_failures; //checks (real or cached) that failed
+     int64_t m_verifyNs;
+
+     Block m_keyContent; //last key parsed, so a batch under one key parses it once
+     std::unique_ptr< ::ndn::security::v1::PublicKey> m_key;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+
+#include "common-random-streams.hpp"
+#include "trace-shards.hpp"
+#include "cs-snapshot.hpp"
+#include "scenario-registry.hpp"
+
+using namespace std;
+
+namespace ns3 {
+namespace ndn {
+
+//has the following topology of:
+/* (N consumers) --- ( ) --- ( ) ---- ( ) --- (producer)
+                      |       |
+                   (evil)  (signer)
+
+    the crowded scenario with any number of consumers behind the first router, consumer i starting i seconds
+    after the first one. With notices on, a consumer that finds a poisoned packet tells the others (a signed
+    Interest under /prefix/notice), and they exclude the bad packet from their first Interest for it instead
+    of going through the poison => key => pursuit loop themselves.
+    Compare total recovery time with and without notices as the number of consumers grows.
+*/
+
+namespace {
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+  // Where the app delay trace goes (replicated or paired runs point this at their own file)
+  std::string traceFile = "results/collaborative-cache-poisoning-app-delays-trace.txt";
+  uint32_t consumers = 3;
+  bool notices = true;
+
+  // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  CommandLine cmd;
+  cmd.AddValue("traceFile", "File to write the app delay trace to", traceFile);
+  cmd.AddValue("consumers", "Number of consumers behind the first router", consumers);
+  cmd.AddValue("notices", "Let consumers notify each other of poisoned packets", notices);
+  cmd.Parse(argc, argv);
+
+  // Creating nodes: 0-3 the line of routers, 4 producer, 5 evil producer, 6 signer, then the consumers
+  NodeContainer nodes;
+  nodes.Create(7);
+  NodeContainer consumerNodes;
+  consumerNodes.Create(consumers);
+
+  // Connecting nodes using links between each one as shown in topology map
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+  p2p.Install(nodes.Get(2), nodes.Get(3));
+  p2p.Install(nodes.Get(2), nodes.Get(4));//"producer"
+  p2p.Install(nodes.Get(5), nodes.Get(2));//evil producer
+  p2p.Install(nodes.Get(6), nodes.Get(3));//signer
+  for(uint32_t i = 0; i < consumers; i++)
+  {
+    p2p.Install(consumerNodes.Get(i), nodes.Get(1));//every consumer connected to router 1
+  }
+
+  // Install NDN stack on all nodes
+  StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Freshness::Lru");
+  ndnHelper.InstallAll();
+
+  // Choosing forwarding strategy (multicast also spreads the notices to every consumer)
+  StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/multicast");
+
+  // Install global routing helper on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  //labeling which node is which:
+  Ptr<Node> goodProducer = nodes.Get(4);
+  Ptr<Node> evilProducer = nodes.Get(5);
+  Ptr<Node> signer = nodes.Get(6);
+
+  // Installing applications
+  std::string dataPrefix = "/prefix/data";
+  std::string keyPrefix = "/prefix/key";
+  std::string noticePrefix = "/prefix/notice";
+  std::string goodPayloadSize = "1024";
+
+  // Consumer i: delay start time of i seconds
+  AppHelper consumerHelper("ns3::ndn::SecurityToyClientApp");
+  consumerHelper.SetPrefix(dataPrefix);
+  consumerHelper.SetAttribute("WaitTime", StringValue("1.0"));
+  consumerHelper.SetAttribute("ReactionTime", StringValue("0.5"));
+  consumerHelper.SetAttribute("KeyName", StringValue(keyPrefix));
+  if(notices)
+  {
+    consumerHelper.SetAttribute("NoticePrefix", StringValue(noticePrefix));
+  }
+  for(uint32_t i = 0; i < consumers; i++)
+  {
+    consumerHelper.SetAttribute("DelayStart", DoubleValue(i));
+    consumerHelper.Install(consumerNodes.Get(i));
+    if(notices)
+    {
+      ndnGlobalRoutingHelper.AddOrigins(noticePrefix, consumerNodes.Get(i));
+    }
+  }
+
+  //Good Producer
+  ndn::AppHelper producerHelper("ns3::ndn::SharedPayloadProducerApp");
+  // Producer will reply to all requests starting with /prefix
+  producerHelper.SetPrefix(dataPrefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue(goodPayloadSize));
+  producerHelper.Install(goodProducer);
+
+  ndnGlobalRoutingHelper.AddOrigins(dataPrefix, goodProducer);
+
+  //Evil Producer
+  ndn::AppHelper evilHelper("ns3::ndn::EvilProducerApp");
+  evilHelper.SetPrefix(dataPrefix);
+  evilHelper.SetAttribute("PayloadSize", StringValue("1000"));
+  evilHelper.Install(evilProducer);
+  ndnGlobalRoutingHelper.AddOrigins(dataPrefix, evilProducer);
+
+  //Signer
+  ndn::AppHelper signerHelper("ns3::ndn::SharedPayloadProducerApp");
+  signerHelper.SetPrefix(keyPrefix);
+  signerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  signerHelper.Install(signer);
+
+  ndnGlobalRoutingHelper.AddOrigins(keyPrefix, signer);
+
+  
+  //supposedly initializes and creates fibs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // Pin the apps' random streams to their nodes so variants run with the same --RngRun share them
+  CommonRandomStreams::AssignAll(0);
+
+  Simulator::Stop(Seconds(20.0));
+
+  ndn::AppDelayTracer::InstallAll(TraceShards::Resolve(traceFile));
+
+  // Warm start from / save of the content stores (--CsSnapshotLoad, --CsSnapshotSave)
+  ndn::CsSnapshot::Install();
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace
+
+} // namespace ndn
+
+} // namespace ns3
+
+NDN_SCENARIO_MAIN(ns3::ndn::main)
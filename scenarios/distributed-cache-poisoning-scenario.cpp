@@ -27,6 +27,11 @@
 #include "ns3/ndnSIM-module.h"
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 
+#include "common-random-streams.hpp"
+#include "trace-shards.hpp"
+#include "cs-snapshot.hpp"
+#include "scenario-registry.hpp"
+
 namespace ns3 {
 
 /**
@@ -41,6 +46,8 @@ namespace ns3 {
  * All links are 1Mbps with propagation 10ms delay.
 */
 
+namespace {
+
 int
 main(int argc, char* argv[])
 {
@@ -49,8 +56,12 @@ main(int argc, char* argv[])
   Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
   Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
 
+  // Where the app delay trace goes (replicated or paired runs point this at their own file)
+  std::string traceFile = "results/distributed-cache-poisoning-app-delays-trace.txt";
+
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
   CommandLine cmd;
+  cmd.AddValue("traceFile", "File to write the app delay trace to", traceFile);
   cmd.Parse(argc, argv);
 
   // Creating 3x3 topology
@@ -109,7 +120,7 @@ main(int argc, char* argv[])
   consumerHelper3.Install(consumer3);
 
   //Good Producer
-  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  ndn::AppHelper producerHelper("ns3::ndn::SharedPayloadProducerApp");
   // Producer will reply to all requests starting with /prefix
   producerHelper.SetPrefix(dataPrefix);
   producerHelper.SetAttribute("PayloadSize", StringValue(goodPayloadSize));
@@ -125,7 +136,7 @@ main(int argc, char* argv[])
   ndnGlobalRoutingHelper.AddOrigins(dataPrefix, evilProducer);
 
   //Signer
-  ndn::AppHelper signerHelper("ns3::ndn::Producer");
+  ndn::AppHelper signerHelper("ns3::ndn::SharedPayloadProducerApp");
   signerHelper.SetPrefix(keyPrefix);
   signerHelper.SetAttribute("PayloadSize", StringValue("1024"));
   signerHelper.Install(signer);
@@ -135,9 +146,15 @@ main(int argc, char* argv[])
   // Calculate and install FIBs
   ndn::GlobalRoutingHelper::CalculateRoutes();
 
+  // Pin the apps' random streams to their nodes so variants run with the same --RngRun share them
+  ndn::CommonRandomStreams::AssignAll(0);
+
   Simulator::Stop(Seconds(20.0));
 
-  ndn::AppDelayTracer::InstallAll("results/distributed-cache-poisoning-app-delays-trace.txt");
+  ndn::AppDelayTracer::InstallAll(ndn::TraceShards::Resolve(traceFile));
+
+  // Warm start from / save of the content stores (--CsSnapshotLoad, --CsSnapshotSave)
+  ndn::CsSnapshot::Install();
 
   Simulator::Run();
   Simulator::Destroy();
@@ -145,10 +162,8 @@ main(int argc, char* argv[])
   return 0;
 }
 
+} // namespace
+
 } // namespace ns3
 
-int
-main(int argc, char* argv[])
-{
-  return ns3::main(argc, argv);
-}
+NDN_SCENARIO_MAIN(ns3::main)
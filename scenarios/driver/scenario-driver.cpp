@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "ns3/core-module.h"
+
+#include "scenario-registry.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//One program for every scenario (./waf configure --scenario-driver):
+//
+//  ./build/ndn-scenarios --list
+//  ./build/ndn-scenarios <scenario> [args ...] [+ <scenario> [args ...] ...]
+//
+//Each scenario gets its own arguments (argv[0] is its name, as if it were its own program). Several
+//scenarios separated by + run back to back in this process; the attribute defaults and global values a
+//scenario changed, and the per-run state the extensions keep in statics (ScenarioRegistry::ResetRunState),
+//are reset before the next one starts.
+
+using namespace ns3::ndn;
+
+static void
+Usage()
+{
+  std::cerr << "usage: ndn-scenarios <scenario> [args ...] [+ <scenario> [args ...] ...]\n"
+            << "       ndn-scenarios --list" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    Usage();
+    return 1;
+  }
+  if (std::strcmp(argv[1], "--list") == 0) {
+    for (const auto& scenario : ScenarioRegistry::GetAll())
+      std::cout << scenario.first << std::endl;
+    return 0;
+  }
+
+  //split the command line at the +
+  std::vector<std::vector<char*>> runs(1);
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "+") == 0)
+      runs.push_back(std::vector<char*>());
+    else
+      runs.back().push_back(argv[i]);
+  }
+
+  for (auto& run : runs) {
+    if (run.empty() || ScenarioRegistry::Find(run[0]) == 0) {
+      std::cerr << "unknown scenario " << (run.empty() ? "" : run[0]) << " (--list shows them)" << std::endl;
+      return 1;
+    }
+  }
+
+  int status = 0;
+  for (size_t r = 0; r < runs.size(); r++) {
+    if (r > 0) {
+      ns3::Config::Reset();
+      ScenarioRegistry::ResetRunState();
+    }
+
+    std::vector<char*>& run = runs[r];
+    run.push_back(nullptr); //argv[argc]
+    int result = ScenarioRegistry::Find(run[0])(run.size() - 1, run.data());
+    if (result != 0 && status == 0)
+      status = result;
+  }
+  return status;
+}
@@ -0,0 +1,272 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+
+#include "common-random-streams.hpp"
+#include "trace-shards.hpp"
+#include "cs-snapshot.hpp"
+#include "scenario-registry.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace ns3 {
+namespace ndn {
+
+//has the following topology of:
+/*  a gridSize x gridSize grid of routers (4x4 shown), consumers (c) hung off the routers in row-major order,
+    the evil producer on the centre router, the producer in the far corner and the signer replicas (s) spread
+    evenly over the grid:
+
+     c --( )------( )------( )------( )
+          |        |        |        |
+     c --( )------( )------( )------( )
+          |        |        |        |
+     s --( )------( )------( )-- evil( )
+          |        |        |        |
+         ( )------( )------( )------( )-- producer
+
+    every signer replica registers /prefix/key as an origin and key Interests go by best route, so each one
+    ends up at the nearest replica (anycast). Key Data never goes stale by default (keyFreshness=0), so the
+    routers' content stores answer repeats.
+    Prints key fetch latency and the key Interests each replica had to answer, e.g. to compare
+    --signers=1 and --signers=4 as --consumers grows.
+*/
+
+static vector<uint64_t> g_signerInterests; //key Interests that reached each replica
+static vector<double> g_keyFetchLatencies; //seconds, every consumer's key fetches
+
+static void
+SignerInterest(uint32_t replica, shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>)
+{
+  g_signerInterests[replica]++;
+}
+
+static void
+KeyFetched(Ptr<App>, uint32_t, Time latency)
+{
+  g_keyFetchLatencies.push_back(latency.GetSeconds());
+}
+
+static double
+Percentile(vector<double>& values, double p)
+{
+  if(values.empty())
+    return 0;
+  size_t rank = static_cast<size_t>(p * (values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+namespace {
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+  // Where the app delay trace goes (replicated or paired runs point this at their own file)
+  std::string traceFile = "results/replicated-signers-app-delays-trace.txt";
+  std::string summaryFile;
+  uint32_t gridSize = 4;
+  uint32_t consumers = 8;
+  uint32_t signers = 1;
+  double keyFreshness = 0;
+
+  // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  CommandLine cmd;
+  cmd.AddValue("traceFile", "File to write the app delay trace to", traceFile);
+  cmd.AddValue("summaryFile", "CSV file to append the key fetch summary of this run to", summaryFile);
+  cmd.AddValue("gridSize", "Routers per side of the grid", gridSize);
+  cmd.AddValue("consumers", "Number of consumers", consumers);
+  cmd.AddValue("signers", "Number of signer replicas serving the key", signers);
+  cmd.AddValue("keyFreshness", "Freshness of the key Data in seconds (0 = never stale)", keyFreshness);
+  cmd.Parse(argc, argv);
+
+  //may not be the first scenario in this process (scenario driver)
+  g_keyFetchLatencies.clear();
+
+  if(gridSize < 2 || signers < 1 || signers > gridSize * gridSize)
+  {
+    std::cerr << "need gridSize >= 2 and 1 <= signers <= gridSize^2" << std::endl;
+    return 1;
+  }
+  uint32_t routers = gridSize * gridSize;
+
+  // Creating nodes: the grid of routers, then producer, evil producer, the signers and the consumers
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(gridSize, gridSize, p2p);
+  grid.BoundingBox(100, 100, 200, 200);
+
+  Ptr<Node> goodProducer = CreateObject<Node>();
+  Ptr<Node> evilProducer = CreateObject<Node>();
+  NodeContainer signerNodes;
+  signerNodes.Create(signers);
+  NodeContainer consumerNodes;
+  consumerNodes.Create(consumers);
+
+  p2p.Install(goodProducer, grid.GetNode(gridSize - 1, gridSize - 1));
+  p2p.Install(evilProducer, grid.GetNode(gridSize / 2, gridSize / 2));
+  for(uint32_t j = 0; j < signers; j++)
+  {
+    //replica j in the middle of its 1/signers share of the routers (row-major)
+    uint32_t router = (2 * j + 1) * routers / (2 * signers);
+    p2p.Install(signerNodes.Get(j), grid.GetNode(router / gridSize, router % gridSize));
+  }
+  for(uint32_t i = 0; i < consumers; i++)
+  {
+    uint32_t router = i % routers;
+    p2p.Install(consumerNodes.Get(i), grid.GetNode(router / gridSize, router % gridSize));
+  }
+
+  // Install NDN stack on all nodes
+  StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Freshness::Lru");
+  ndnHelper.InstallAll();
+
+  // Choosing forwarding strategy: data as in the other poisoning scenarios, keys to the nearest replica
+  StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/multicast");
+  StrategyChoiceHelper::InstallAll("/prefix/key", "/localhost/nfd/strategy/best-route");
+
+  // Install global routing helper on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // Installing applications
+  std::string dataPrefix = "/prefix/data";
+  std::string keyPrefix = "/prefix/key";
+  std::string goodPayloadSize = "1024";
+
+  // Consumer i: delay start time of i/10 seconds
+  AppHelper consumerHelper("ns3::ndn::SecurityToyClientApp");
+  consumerHelper.SetPrefix(dataPrefix);
+  consumerHelper.SetAttribute("WaitTime", StringValue("1.0"));
+  consumerHelper.SetAttribute("ReactionTime", StringValue("0.5"));
+  consumerHelper.SetAttribute("KeyName", StringValue(keyPrefix));
+  for(uint32_t i = 0; i < consumers; i++)
+  {
+    consumerHelper.SetAttribute("DelayStart", DoubleValue(0.1 * i));
+    ApplicationContainer app = consumerHelper.Install(consumerNodes.Get(i));
+    app.Get(0)->TraceConnectWithoutContext("KeyFetchLatency", MakeCallback(&KeyFetched));
+  }
+
+  //Good Producer
+  ndn::AppHelper producerHelper("ns3::ndn::SharedPayloadProducerApp");
+  producerHelper.SetPrefix(dataPrefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue(goodPayloadSize));
+  producerHelper.Install(goodProducer);
+  ndnGlobalRoutingHelper.AddOrigins(dataPrefix, goodProducer);
+
+  //Evil Producer
+  ndn::AppHelper evilHelper("ns3::ndn::EvilProducerApp");
+  evilHelper.SetPrefix(dataPrefix);
+  evilHelper.SetAttribute("PayloadSize", StringValue("1000"));
+  evilHelper.Install(evilProducer);
+  ndnGlobalRoutingHelper.AddOrigins(dataPrefix, evilProducer);
+
+  //Signer replicas, all origins of the key prefix
+  ndn::AppHelper signerHelper("ns3::ndn::SharedPayloadProducerApp");
+  signerHelper.SetPrefix(keyPrefix);
+  signerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  signerHelper.SetAttribute("Freshness", TimeValue(Seconds(keyFreshness)));
+  g_signerInterests.assign(signers, 0);
+  for(uint32_t j = 0; j < signers; j++)
+  {
+    ApplicationContainer app = signerHelper.Install(signerNodes.Get(j));
+    app.Get(0)->TraceConnectWithoutContext("ReceivedInterests", MakeBoundCallback(&SignerInterest, j));
+    ndnGlobalRoutingHelper.AddOrigins(keyPrefix, signerNodes.Get(j));
+  }
+
+  //supposedly initializes and creates fibs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // Pin the apps' random streams to their nodes so variants run with the same --RngRun share them
+  CommonRandomStreams::AssignAll(0);
+
+  Simulator::Stop(Seconds(20.0));
+
+  ndn::AppDelayTracer::InstallAll(TraceShards::Resolve(traceFile));
+
+  // Warm start from / save of the content stores (--CsSnapshotLoad, --CsSnapshotSave)
+  ndn::CsSnapshot::Install();
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  uint64_t signerTotal = 0;
+  uint64_t signerMax = 0;
+  for(uint64_t interests : g_signerInterests)
+  {
+    signerTotal += interests;
+    signerMax = std::max(signerMax, interests);
+  }
+  double latencyMean = 0;
+  for(double latency : g_keyFetchLatencies)
+  {
+    latencyMean += latency / g_keyFetchLatencies.size();
+  }
+  double latencyMedian = Percentile(g_keyFetchLatencies, 0.5);
+  double latencyP95 = Percentile(g_keyFetchLatencies, 0.95);
+
+  std::cout << "consumers=" << consumers << " signers=" << signers
+            << " key-fetches=" << g_keyFetchLatencies.size()
+            << " key-latency-mean=" << latencyMean << "s median=" << latencyMedian << "s p95=" << latencyP95 << "s"
+            << " signer-interests=" << signerTotal << " busiest-signer=" << signerMax << std::endl;
+
+  if(!summaryFile.empty())
+  {
+    bool header = !std::ifstream(summaryFile.c_str()).good();
+    std::ofstream summary(summaryFile.c_str(), std::ios::app);
+    if(header)
+    {
+      summary << "Consumers,Signers,KeyFreshness,KeyFetches,KeyLatencyMean,KeyLatencyMedian,KeyLatencyP95,"
+              << "SignerInterests,BusiestSigner" << std::endl;
+    }
+    summary << consumers << "," << signers << "," << keyFreshness << "," << g_keyFetchLatencies.size() << ","
+            << latencyMean << "," << latencyMedian << "," << latencyP95 << ","
+            << signerTotal << "," << signerMax << std::endl;
+  }
+
+  return 0;
+}
+
+} // namespace
+
+} // namespace ndn
+
+} // namespace ns3
+
+NDN_SCENARIO_MAIN(ns3::ndn::main)
@@ -0,0 +1,215 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+
+#include "common-random-streams.hpp"
+#include "trace-shards.hpp"
+#include "cs-snapshot.hpp"
+#include "scenario-registry.hpp"
+#include "signed-producer-app.hpp"
+#include "crypto-cost-model.hpp"
+
+using namespace std;
+
+namespace ns3 {
+namespace ndn {
+
+//has the following topology of:
+/* (consumer) --- ( ) --- ( ) ---- ( ) --- (producer)
+                   |       |
+                (evil)  (signer)
+
+    same as the basic scenario, but the producer really signs its data, the signer serves the producer's
+    public key and the consumer verifies the data's signature against it (the evil producer's dummy
+    signature fails) instead of judging the data by its payload size
+*/
+
+namespace {
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+  // Where the app delay trace goes (replicated or paired runs point this at their own file)
+  std::string traceFile = "results/signed-cache-poisoning-app-delays-trace.txt";
+  std::string algorithm = "ecdsa";
+  uint32_t preSign = 0;
+  bool cryptoCost = false;
+  uint32_t consumers = 1;
+  bool coalesce = false;
+  bool badDataFilter = false;
+  bool prefilter = false;
+  bool speculative = false;
+
+  // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
+  CommandLine cmd;
+  cmd.AddValue("traceFile", "File to write the app delay trace to", traceFile);
+  cmd.AddValue("algorithm", "Producer signature: rsa, ecdsa or sha256", algorithm);
+  cmd.AddValue("preSign", "Sign this many sequence numbers on all cores before the run (0 = sign on demand)",
+               preSign);
+  cmd.AddValue("cryptoCost", "Charge the calibrated sign/verify cost as simulated delay", cryptoCost);
+  cmd.AddValue("consumers", "Number of consumer apps on the consumer node", consumers);
+  cmd.AddValue("coalesce", "Let the consumers on the node share key fetches and verify in batches", coalesce);
+  cmd.AddValue("badDataFilter", "Drop Data the consumer node already found bad without another key fetch",
+               badDataFilter);
+  cmd.AddValue("prefilter", "Verify only the Data the anomaly prefilter finds suspicious (prints its accuracy)",
+               prefilter);
+  cmd.AddValue("speculative", "Use Data before its verdict and roll it back when verification fails", speculative);
+  cmd.Parse(argc, argv);
+
+  // Creating nodes
+  NodeContainer nodes;
+  nodes.Create(7);
+
+  // Connecting nodes using links between each one as shown in topology map
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1)); //consumer connected to one router
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+  p2p.Install(nodes.Get(2), nodes.Get(3));
+  p2p.Install(nodes.Get(2), nodes.Get(4));//"producer"
+  p2p.Install(nodes.Get(5), nodes.Get(2));//evil producer
+  p2p.Install(nodes.Get(6), nodes.Get(3));//signer
+
+  // Install NDN stack on all nodes
+  StackHelper ndnHelper;
+  ndnHelper.SetOldContentStore("ns3::ndn::cs::Freshness::Lru");
+  ndnHelper.InstallAll();
+
+  // Choosing forwarding strategy (can change this later when defining consumer and producer)
+  StrategyChoiceHelper::InstallAll("/prefix", "/localhost/nfd/strategy/multicast");
+
+  // Install global routing helper on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  //labeling which node is which:
+  Ptr<Node> goodProducer = nodes.Get(4);
+  Ptr<Node> evilProducer = nodes.Get(5);
+  Ptr<Node> signer = nodes.Get(6);
+  NodeContainer consumerNodes;
+  consumerNodes.Add(nodes.Get(0));
+
+  // Installing applications
+  std::string dataPrefix = "/prefix/data";
+  std::string keyPrefix = "/prefix/key";
+  std::string identity = keyPrefix; //consumers only take Data whose KeyLocator is under their KeyName
+  std::string evilComponent = "/evil";
+  std::string goodPayloadSize = "1024";
+
+  // Consumer
+  AppHelper consumerHelper("ns3::ndn::SecurityToyClientApp");
+  consumerHelper.SetPrefix(dataPrefix);
+  consumerHelper.SetAttribute("WaitTime", StringValue("1.0"));//sends out a new interest for a packet per this int.
+  consumerHelper.SetAttribute("ReactionTime", StringValue("0.5"));
+  consumerHelper.SetAttribute("KeyName", StringValue(keyPrefix));
+  consumerHelper.SetAttribute("VerifySignatures", BooleanValue(true));
+  consumerHelper.SetAttribute("SimulateCryptoCost", BooleanValue(cryptoCost));
+  consumerHelper.SetAttribute("KeyAlgorithm", StringValue(algorithm));
+  consumerHelper.SetAttribute("CoalesceKeyFetches", BooleanValue(coalesce));
+  consumerHelper.SetAttribute("UseBadDataFilter", BooleanValue(badDataFilter));
+  consumerHelper.SetAttribute("UseAnomalyPrefilter", BooleanValue(prefilter));
+  consumerHelper.SetAttribute("ReportStats", BooleanValue(prefilter));
+  consumerHelper.SetAttribute("Speculative", BooleanValue(speculative));
+  for(uint32_t i = 0; i < consumers; i++)
+  {
+    consumerHelper.Install(consumerNodes);
+  }
+
+  //Good Producer (signs with the identity's key)
+  ndn::AppHelper producerHelper("ns3::ndn::SignedProducerApp");
+  // Producer will reply to all requests starting with /prefix
+  producerHelper.SetPrefix(dataPrefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue(goodPayloadSize));
+  producerHelper.SetAttribute("Identity", StringValue(identity));
+  producerHelper.SetAttribute("Algorithm", StringValue(algorithm));
+  producerHelper.SetAttribute("PreSignMaxSeq", UintegerValue(preSign));
+  producerHelper.SetAttribute("SimulateCryptoCost", BooleanValue(cryptoCost));
+  producerHelper.Install(goodProducer);
+
+  ndnGlobalRoutingHelper.AddOrigins(dataPrefix, goodProducer);
+
+  //Evil Producer
+  ndn::AppHelper evilHelper("ns3::ndn::EvilProducerApp");
+  evilHelper.SetPrefix(dataPrefix);
+  evilHelper.SetAttribute("PayloadSize", StringValue("1000"));
+  evilHelper.Install(evilProducer);
+  ndnGlobalRoutingHelper.AddOrigins(dataPrefix, evilProducer);
+
+  //Signer (serves the producer's public key)
+  ndn::AppHelper signerHelper("ns3::ndn::SignedProducerApp");
+  signerHelper.SetPrefix(keyPrefix);
+  signerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  signerHelper.SetAttribute("Identity", StringValue(identity));
+  signerHelper.SetAttribute("Algorithm", StringValue(algorithm));
+  signerHelper.SetAttribute("ServeKey", BooleanValue(true));
+  signerHelper.SetAttribute("SimulateCryptoCost", BooleanValue(cryptoCost));
+  signerHelper.Install(signer);
+
+  ndnGlobalRoutingHelper.AddOrigins(keyPrefix, signer);
+
+  
+  //supposedly initializes and creates fibs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  // Pin the apps' random streams to their nodes so variants run with the same --RngRun share them
+  CommonRandomStreams::AssignAll(0);
+
+  // Sign the producer's corpus up front when asked to (wall-clock only, no simulated time)
+  SignedProducerApp::PreSignAll();
+
+  // Measure the sign/verify cost now, so the microbenchmark is not timed as part of the run
+  if(cryptoCost)
+  {
+    CryptoCostModel::Calibrate(SigningKeyChain::ParseAlgorithm(algorithm), 0);
+  }
+
+  Simulator::Stop(Seconds(20.0));
+
+  ndn::AppDelayTracer::InstallAll(TraceShards::Resolve(traceFile));
+
+  // Warm start from / save of the content stores (--CsSnapshotLoad, --CsSnapshotSave)
+  ndn::CsSnapshot::Install();
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace
+
+} // namespace ndn
+
+} // namespace ns3
+
+NDN_SCENARIO_MAIN(ns3::ndn::main)
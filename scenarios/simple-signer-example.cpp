@@ -27,12 +27,18 @@
 
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 
+#include "trace-shards.hpp"
+#include "cs-snapshot.hpp"
+#include "scenario-registry.hpp"
+
 using namespace std;
 
 namespace ns3 {
 namespace ndn {
 
 
+namespace {
+
 int
 main(int argc, char* argv[])
 {
@@ -41,8 +47,12 @@ main(int argc, char* argv[])
   Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
   Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
 
+  // Where the app delay trace goes (replicated or paired runs point this at their own file)
+  std::string traceFile = "results/simple-signer-app-delays-trace.txt";
+
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
   CommandLine cmd;
+  cmd.AddValue("traceFile", "File to write the app delay trace to", traceFile);
   cmd.Parse(argc, argv);
 
   // Creating nodes
@@ -82,7 +92,7 @@ main(int argc, char* argv[])
   consumerHelper.Install(nodes.Get(0));                        // first node
 
   // Producer
-  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  ndn::AppHelper producerHelper("ns3::ndn::SharedPayloadProducerApp");
   // Producer will reply to all requests starting with /prefix
   producerHelper.SetPrefix(dataPrefix);
   producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
@@ -91,7 +101,7 @@ main(int argc, char* argv[])
   ndnGlobalRoutingHelper.AddOrigins(dataPrefix, nodes.Get(4));
 
   //Signer is a producer that replies with the "key" for Producer's data
-  ndn::AppHelper signerHelper("ns3::ndn::Producer");
+  ndn::AppHelper signerHelper("ns3::ndn::SharedPayloadProducerApp");
   signerHelper.SetPrefix(keyPrefix);
   signerHelper.SetAttribute("PayloadSize", StringValue("1024"));
   signerHelper.Install(nodes.Get(3));
@@ -104,7 +114,10 @@ main(int argc, char* argv[])
 
   Simulator::Stop(Seconds(20.0));
 
-  ndn::AppDelayTracer::InstallAll("results/simple-signer-app-delays-trace.txt");
+  ndn::AppDelayTracer::InstallAll(TraceShards::Resolve(traceFile));
+
+  // Warm start from / save of the content stores (--CsSnapshotLoad, --CsSnapshotSave)
+  ndn::CsSnapshot::Install();
 
   Simulator::Run();
   Simulator::Destroy();
@@ -112,12 +125,10 @@ main(int argc, char* argv[])
   return 0;
 }
 
+} // namespace
+
 } // namespace ndn
 
 } // namespace ns3
 
-int
-main(int argc, char* argv[])
-{
-  return ns3::ndn::main(argc, argv);
-}
+NDN_SCENARIO_MAIN(ns3::ndn::main)
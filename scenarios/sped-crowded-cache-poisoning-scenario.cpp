@@ -28,6 +28,11 @@
 
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
 
+#include "common-random-streams.hpp"
+#include "trace-shards.hpp"
+#include "cs-snapshot.hpp"
+#include "scenario-registry.hpp"
+
 using namespace std;
 
 namespace ns3 {
@@ -44,6 +49,8 @@ namespace ndn {
    This scenario uses 3 consumers each with a different amount of delay to see the impact the cache had on the other 2 consumers.
 */                 
 
+namespace {
+
 int
 main(int argc, char* argv[])
 {
@@ -52,8 +59,12 @@ main(int argc, char* argv[])
   Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
   Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
 
+  // Where the app delay trace goes (replicated or paired runs point this at their own file)
+  std::string traceFile = "results/sped-crowded-cache-poisoning-app-delays-trace.txt";
+
   // Read optional command-line parameters (e.g., enable visualizer with ./waf --run=<> --visualize
   CommandLine cmd;
+  cmd.AddValue("traceFile", "File to write the app delay trace to", traceFile);
   cmd.Parse(argc, argv);
 
   // Creating nodes
@@ -123,7 +134,7 @@ main(int argc, char* argv[])
   consumerHelper3.Install(consumer3);
 
   //Good Producer
-  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  ndn::AppHelper producerHelper("ns3::ndn::SharedPayloadProducerApp");
   // Producer will reply to all requests starting with /prefix
   producerHelper.SetPrefix(dataPrefix);
   producerHelper.SetAttribute("PayloadSize", StringValue(goodPayloadSize));
@@ -139,7 +150,7 @@ main(int argc, char* argv[])
   ndnGlobalRoutingHelper.AddOrigins(dataPrefix, evilProducer);
 
   //Signer
-  ndn::AppHelper signerHelper("ns3::ndn::Producer");
+  ndn::AppHelper signerHelper("ns3::ndn::SharedPayloadProducerApp");
   signerHelper.SetPrefix(keyPrefix);
   signerHelper.SetAttribute("PayloadSize", StringValue("1024"));
   signerHelper.Install(signer);
@@ -150,9 +161,15 @@ main(int argc, char* argv[])
   //supposedly initializes and creates fibs
   ndn::GlobalRoutingHelper::CalculateRoutes();
 
+  // Pin the apps' random streams to their nodes so variants run with the same --RngRun share them
+  CommonRandomStreams::AssignAll(0);
+
   Simulator::Stop(Seconds(20.0));
 
-  ndn::AppDelayTracer::InstallAll("results/sped-crowded-cache-poisoning-app-delays-trace.txt");
+  ndn::AppDelayTracer::InstallAll(TraceShards::Resolve(traceFile));
+
+  // Warm start from / save of the content stores (--CsSnapshotLoad, --CsSnapshotSave)
+  ndn::CsSnapshot::Install();
 
   Simulator::Run();
   Simulator::Destroy();
@@ -160,12 +177,10 @@ main(int argc, char* argv[])
   return 0;
 }
 
+} // namespace
+
 } // namespace ndn
 
 } // namespace ns3
 
-int
-main(int argc, char* argv[])
-{
-  return ns3::ndn::main(argc, argv);
-}
+NDN_SCENARIO_MAIN(ns3::ndn::main)
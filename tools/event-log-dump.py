@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Prints the binary event log written with --EventLogFile (see
+extensions/event-ring-logger.hpp) as text, one record per line.  Records come
+out in the order the rings were drained, use --sort to order them by time.
+"""
+
+from __future__ import print_function
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"NDNEVLOG"
+RECORD = struct.Struct("=qIIIHHQ")
+
+# keep in sync with EventType in extensions/event-ring-logger.hpp
+TYPES = {
+    1: ("INTEREST_SENT", "nonce"),
+    2: ("PURSUIT_SENT", "nonce"),
+    3: ("KEY_INTEREST_SENT", "nonce"),
+    4: ("DATA_RECEIVED", "size"),
+    5: ("EVIL_DATA", "size"),
+    6: ("KEY_RECEIVED", "keySeq"),
+    7: ("PURSUIT_STARTED", "-"),
+    8: ("NACK_RECEIVED", "reason"),
+    9: ("EVIL_DATA_SENT", "size"),
+    10: ("SIGNATURE_CHECKED", "-"),
+    11: ("KNOWN_BAD_DROPPED", "size"),
+    12: ("NOTICE_SENT", "-"),
+    13: ("NOTICE_RECEIVED", "-"),
+    14: ("PREFILTER_TRUSTED", "score"),
+    15: ("ROLLBACK", "usInUse"),
+}
+
+def read_records(path):
+    with open(path, "rb") as f:
+        if f.read(len(MAGIC)) != MAGIC:
+            raise ValueError("%s is not an event log" % path)
+        version, size = struct.unpack("=II", f.read(8))
+        if version != 1 or size != RECORD.size:
+            raise ValueError("unsupported event log version %d (record size %d)" % (version, size))
+        while True:
+            chunk = f.read(RECORD.size)
+            if len(chunk) < RECORD.size:
+                break
+            yield RECORD.unpack(chunk)
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary app event log')
+    parser.add_argument('file', help='Event log written with --EventLogFile')
+    parser.add_argument('--sort', action='store_true', default=False, help='Order the records by time')
+    args = parser.parse_args()
+
+    records = read_records(args.file)
+    if args.sort:
+        records = sorted(records, key=lambda r: r[0])
+
+    print("Time\tNode\tAppId\tSeqNo\tEvent\tHopCount\tArg")
+    for time, node, app, seq, kind, flags, arg in records:
+        name, arg_name = TYPES.get(kind, ("UNKNOWN(%d)" % kind, "arg"))
+        print("%.9f\t%d\t%d\t%d\t%s\t%d\t%s=%d" % (time / 1e9, node, app, seq, name, flags, arg_name, arg))
+
+if __name__ == '__main__':
+    sys.exit(main())
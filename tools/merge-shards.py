@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Merges the per-run trace shards written with --TraceShardDir (see
+extensions/trace-shards.hpp) back into one trace, ordered by time.
+
+Every app delay trace shard is already in time order, so the merge streams: it
+keeps one record per shard in memory, whatever the number or size of the shards.
+An event log shard is only in order per app (the rings drain in turns), so each
+one is read whole and sorted before it joins the merge.  A Run column
+(the shard's RngRun, pid and run in the process, as in the index) is put in front of every record so
+runs stay apart.  App delay trace shards merge into a text trace with the same
+columns; event log shards merge into the text that tools/event-log-dump.py
+prints.
+
+  tools/merge-shards.py results/shards/basic-cache-poisoning-app-delays-trace.index -o merged.txt
+"""
+
+from __future__ import print_function
+
+import argparse
+import heapq
+import os
+import sys
+
+def load_event_log_dump():
+    "event-log-dump.py, which knows the event log format (not importable by name because of the dash)"
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "event-log-dump.py")
+    try:
+        import importlib.util
+        spec = importlib.util.spec_from_file_location("eventlog", path)
+        module = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(module)
+        return module
+    except ImportError:
+        import imp
+        return imp.load_source("eventlog", path)
+
+eventlog = load_event_log_dump()
+
+def read_index(path):
+    "(shard path, run label) for every line of an index"
+    shards = []
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) not in (3, 4):
+                continue
+            shards.append((fields[0], "-".join(fields[1:])))
+    return shards
+
+def is_event_log(path):
+    with open(path, "rb") as f:
+        return f.read(len(eventlog.MAGIC)) == eventlog.MAGIC
+
+def text_records(path, run):
+    "(time, run, line) for every record of an app delay trace shard"
+    with open(path) as f:
+        header = f.readline().split()
+        time_column = header.index("Time")
+        for line in f:
+            fields = line.split()
+            if len(fields) != len(header):
+                continue
+            yield (float(fields[time_column]), run, "\t".join(fields))
+
+def event_records(path, run):
+    "(time, run, line) for every record of an event log shard (drained ring by ring, so sorted per app first)"
+    rings = {}
+    for record in eventlog.read_records(path):
+        rings.setdefault((record[1], record[2]), []).append(record)
+    for records in rings.values():
+        records.sort(key=lambda r: r[0])
+    for time, node, app, seq, kind, flags, arg in heapq.merge(*rings.values()):
+        name, arg_name = eventlog.TYPES.get(kind, ("UNKNOWN(%d)" % kind, "arg"))
+        yield (time / 1e9, run, "%.9f\t%d\t%d\t%d\t%s\t%d\t%s=%d" % (time / 1e9, node, app, seq, name, flags,
+                                                                   arg_name, arg))
+
+def main():
+    parser = argparse.ArgumentParser(description='Merge trace shards by time')
+    parser.add_argument('index', nargs='+', help='Shard index (<TraceShardDir>/<trace name>.index)')
+    parser.add_argument('-o', '--output', default='-', help='Merged trace (default: stdout)')
+    args = parser.parse_args()
+
+    shards = []
+    for index in args.index:
+        shards.extend(read_index(index))
+    shards = [(path, run) for path, run in shards if os.path.exists(path)]
+    if not shards:
+        print("no shards found", file=sys.stderr)
+        return 1
+
+    events = is_event_log(shards[0][0])
+    if any(is_event_log(path) != events for path, run in shards):
+        print("cannot merge event logs with app delay traces", file=sys.stderr)
+        return 1
+
+    if events:
+        header = "Time\tNode\tAppId\tSeqNo\tEvent\tHopCount\tArg"
+        streams = [event_records(path, run) for path, run in shards]
+    else:
+        with open(shards[0][0]) as f:
+            header = "\t".join(f.readline().split())
+        streams = [text_records(path, run) for path, run in shards]
+
+    out = sys.stdout if args.output == '-' else open(args.output, 'w')
+    out.write("Run\t%s\n" % header)
+    for time, run, line in heapq.merge(*streams):
+        out.write("%s\t%s\n" % (run, line))
+    if out is not sys.stdout:
+        out.close()
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,103 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Common-random-numbers paired comparison of two scenario variants.
+
+Replication i of variant A and replication i of variant B both run with
+--RngRun=i.  The scenarios pin the apps' random streams to their nodes (see
+extensions/common-random-streams.hpp), so both variants draw the same Interest
+nonces, start jitter and attacker decisions and the noise mostly cancels in the
+per-pair differences.
+
+Example (run from the top of the repo after ./waf):
+    ./tools/paired.py basic-cache-poisoning-scenario sped-basic-cache-poisoning-scenario -n 20 \\
+        --args="--ns3::ndn::SecurityToyClientApp::StartJitter=0.5 --ns3::ndn::EvilProducerApp::AnswerProbability=0.7"
+"""
+
+from __future__ import print_function, division
+
+import argparse
+import multiprocessing
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import simtools
+
+def run_one(job):
+    name, trace_file, args, rng_run = job
+    status = simtools.run_scenario(name, trace_file, args, rng_run)
+    return (name, rng_run, status)
+
+def main():
+    parser = argparse.ArgumentParser(description='Paired (common random numbers) comparison of two scenarios')
+    parser.add_argument('variant_a', help='Scenario program for variant A')
+    parser.add_argument('variant_b', help='Scenario program for variant B')
+    parser.add_argument('-n', '--pairs', type=int, default=10, help='Number of pairs to run (default 10)')
+    parser.add_argument('--first-run', type=int, default=1, help='RngRun of the first pair (default 1)')
+    parser.add_argument('-j', '--jobs', type=int, default=multiprocessing.cpu_count(),
+                        help='Replications to run in parallel (default: all cores)')
+    parser.add_argument('--args', default='', help='Extra arguments passed to both variants')
+    parser.add_argument('-o', '--output', default=os.path.join(simtools.RESULTS_DIR, 'paired'),
+                        help='Directory for the per-run traces and the summary csv')
+    parser.add_argument('-c', '--confidence', type=float, default=0.95, help='Confidence level (default 0.95)')
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.output):
+        os.makedirs(args.output)
+
+    extra = args.args.split()
+    runs = range(args.first_run, args.first_run + args.pairs)
+
+    def trace(name, run):
+        return os.path.join(args.output, "%s-run-%d-app-delays-trace.txt" % (name, run))
+
+    jobs = [(name, trace(name, run), extra, run)
+            for run in runs for name in (args.variant_a, args.variant_b)]
+
+    pool = multiprocessing.Pool(args.jobs)
+    try:
+        for name, run, status in pool.imap_unordered(run_one, jobs):
+            if status != 0:
+                print("ERROR: %s --RngRun=%d exited with %d" % (name, run, status))
+                return 1
+    finally:
+        pool.close()
+        pool.join()
+
+    results = {}
+    for run in runs:
+        a = simtools.trace_metrics(simtools.read_trace(trace(args.variant_a, run)))
+        b = simtools.trace_metrics(simtools.read_trace(trace(args.variant_b, run)))
+        results[run] = (a, b)
+
+    csv = os.path.join(args.output, "%s-vs-%s-paired.csv" % (args.variant_a, args.variant_b))
+    with open(csv, "w") as f:
+        f.write("RngRun,Metric,A,B,Diff\n")
+        for run in runs:
+            a, b = results[run]
+            for metric in simtools.METRICS:
+                f.write("%d,%s,%g,%g,%g\n" % (run, metric, a[metric], b[metric], b[metric] - a[metric]))
+
+    print("A = %s, B = %s, %d pairs, %g%% confidence" % (args.variant_a, args.variant_b,
+                                                        len(runs), args.confidence * 100))
+    print("%-16s %12s %12s %12s %12s %10s" % ("Metric", "mean(A)", "mean(B)", "mean(B-A)", "+/-", "VR"))
+    for metric in simtools.METRICS:
+        a = [results[run][0][metric] for run in runs]
+        b = [results[run][1][metric] for run in runs]
+        diff = [y - x for x, y in zip(a, b)]
+
+        # variance reduction: how many times more unpaired replications the same interval would need
+        paired = simtools.variance(diff)
+        unpaired = simtools.variance(a) + simtools.variance(b)
+        reduction = "%.1fx" % (unpaired / paired) if paired > 0 else "-"
+
+        print("%-16s %12.6f %12.6f %12.6f %12.6f %10s" % (metric, simtools.mean(a), simtools.mean(b),
+                                                          simtools.mean(diff),
+                                                          simtools.ci_half_width(diff, args.confidence),
+                                                          reduction))
+    print("Per-pair differences written to " + csv)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
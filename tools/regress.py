@@ -0,0 +1,184 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Whole-simulation regression harness.
+
+Runs every scenario (or the ones given) one after the other and
+  * checks its app delay trace against the committed golden trace in results/
+    (same records, times and delays within tolerance), so an optimization can't
+    quietly change what the simulation does
+  * records wall time, executed events, events per second and peak RSS in a
+    history file, and flags runs that are slower than the recent history
+
+Events are counted by running with --SchedulerType=ns3::ndn::CountingScheduler.
+A scenario without a golden trace yet is reported as skipped: it is still
+timed, but its behaviour is not checked.  Exits non-zero when a trace differs
+or a scenario fails (or, with --fail-on-slowdown, when a scenario got slower
+than the threshold).
+"""
+
+from __future__ import print_function, division
+
+import argparse
+import datetime
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import simtools
+
+STATS_LINE = re.compile(r"CountingScheduler: scheduled=(\d+) executed=(\d+) removed=(\d+) "
+                        r"peak-queue=(\d+) run-wall-s=(\S+) events-per-s=(\S+)")
+
+HISTORY_HEADER = "Date,Commit,Scenario,WallS,Events,EventsPerS,PeakRssKB,Behaviour\n"
+
+def run_measured(name, trace_file):
+    "Runs a scenario; returns (status, wall seconds, peak rss in KB, stderr text)"
+    cmdline = simtools.scenario_command(name, ["--traceFile=%s" % trace_file,
+                                               "--SchedulerType=ns3::ndn::CountingScheduler"])
+    with open(os.devnull, "w") as devnull:
+        with tempfile.TemporaryFile(mode="w+") as err:
+            start = time.time()
+            process = subprocess.Popen(cmdline, stdout=devnull, stderr=err)
+            # wait4 gives the resource usage of this one child (ru_maxrss is in KB on Linux)
+            pid, status, usage = os.wait4(process.pid, 0)
+            wall = time.time() - start
+            process.returncode = status
+            err.seek(0)
+            return (os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1, wall, usage.ru_maxrss, err.read())
+
+def compare_traces(golden, actual, abs_tol, rel_tol):
+    "Returns None when the traces match, else a description of the first difference"
+    expected = simtools.read_trace(golden)
+    got = simtools.read_trace(actual)
+    if len(expected) != len(got):
+        return "%d records instead of %d" % (len(got), len(expected))
+    for i, (e, g) in enumerate(zip(expected, got)):
+        for key in ("Node", "AppId", "SeqNo", "Type", "RetxCount", "HopCount"):
+            if e[key] != g[key]:
+                return "record %d: %s is %s instead of %s" % (i + 1, key, g[key], e[key])
+        for key in ("Time", "DelayS"):
+            if abs(e[key] - g[key]) > abs_tol + rel_tol * abs(e[key]):
+                return "record %d: %s is %g instead of %g" % (i + 1, key, g[key], e[key])
+    return None
+
+def read_history(path):
+    history = {}
+    if not os.path.exists(path):
+        return history
+    with open(path) as f:
+        f.readline()
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) == 8 and fields[7] in ("ok", "skipped"):
+                history.setdefault(fields[2], []).append(float(fields[3]))
+    return history
+
+def median(values):
+    values = sorted(values)
+    return values[len(values) // 2]
+
+def git_commit():
+    try:
+        with open(os.devnull, "w") as devnull:
+            return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"],
+                                           stderr=devnull).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+def main():
+    parser = argparse.ArgumentParser(description='Check scenarios against the golden traces and track their speed')
+    parser.add_argument('scenarios', metavar='scenario', nargs='*',
+                        help='Scenarios to check (default: every scenario in scenarios/)')
+    parser.add_argument('--abs-tolerance', type=float, default=1e-6,
+                        help='Absolute tolerance in seconds for Time and DelayS (default 1e-6)')
+    parser.add_argument('--rel-tolerance', type=float, default=1e-9,
+                        help='Relative tolerance for Time and DelayS (default 1e-9)')
+    parser.add_argument('--threshold', type=float, default=0.10,
+                        help='Flag a scenario whose wall time exceeds the recent median by this fraction (default 0.10)')
+    parser.add_argument('--window', type=int, default=5,
+                        help='Number of recent passing runs the median is taken over (default 5)')
+    parser.add_argument('--history', default=os.path.join(simtools.RESULTS_DIR, 'perf-history.csv'),
+                        help='History file (default: %(default)s)')
+    parser.add_argument('--no-record', dest='record', action='store_false', default=True,
+                        help='Do not append this run to the history file')
+    parser.add_argument('--fail-on-slowdown', action='store_true', default=False,
+                        help='Exit non-zero when a scenario is flagged as slower')
+    args = parser.parse_args()
+
+    names = args.scenarios or simtools.scenario_names()
+    history = read_history(args.history)
+    commit = git_commit()
+    date = datetime.datetime.now().strftime("%Y-%m-%dT%H:%M:%S")
+    scratch = tempfile.mkdtemp(prefix="regress-")
+
+    mismatches = 0
+    skipped = 0
+    slowdowns = 0
+    records = []
+
+    print("%-44s %9s %10s %12s %10s  %s" % ("Scenario", "Wall s", "Events", "Events/s", "Peak KB", "Result"))
+    for name in names:
+        golden = simtools.golden_trace(name)
+        trace = os.path.join(scratch, os.path.basename(golden))
+        status, wall, rss, err = run_measured(name, trace)
+
+        events = 0
+        rate = 0.0
+        stats = STATS_LINE.search(err)
+        if stats:
+            events = int(stats.group(2))
+            rate = float(stats.group(6))
+
+        if status != 0:
+            behaviour = "exit %d" % status
+        elif not os.path.exists(golden):
+            behaviour = "skipped"
+        else:
+            difference = compare_traces(golden, trace, args.abs_tolerance, args.rel_tolerance)
+            behaviour = "ok" if difference is None else "DIFFERS: " + difference
+        ran = behaviour in ("ok", "skipped")
+        if behaviour == "skipped":
+            skipped += 1
+        elif not ran:
+            mismatches += 1
+
+        result = "skipped (no golden trace)" if behaviour == "skipped" else behaviour
+        past = history.get(name, [])[-args.window:]
+        if ran and past:
+            baseline = median(past)
+            if wall > baseline * (1 + args.threshold):
+                slowdowns += 1
+                result += " SLOWER (%.0f%% over median %.3fs)" % ((wall / baseline - 1) * 100, baseline)
+
+        print("%-44s %9.3f %10d %12.0f %10d  %s" % (name, wall, events, rate, rss, result))
+        records.append("%s,%s,%s,%.6f,%d,%.1f,%d,%s\n" % (date, commit, name, wall, events, rate, rss,
+                                                          behaviour if ran else "differs"))
+
+    shutil.rmtree(scratch)
+
+    if args.record:
+        new_file = not os.path.exists(args.history)
+        with open(args.history, "a") as f:
+            if new_file:
+                f.write(HISTORY_HEADER)
+            f.writelines(records)
+
+    if mismatches:
+        print("%d scenario(s) no longer match their golden traces" % mismatches)
+    if skipped:
+        print("%d scenario(s) skipped, no golden trace in %s" % (skipped, simtools.RESULTS_DIR))
+    if slowdowns:
+        print("%d scenario(s) slower than %.0f%% over their recent median" % (slowdowns, args.threshold * 100))
+
+    if mismatches or (slowdowns and args.fail_on_slowdown):
+        return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,166 @@
+#!/usr/bin/env python
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Sequential-stopping replication controller.
+
+Keeps launching replications (--RngRun=1, 2, ...) of every requested point in
+parallel until the confidence interval of each chosen metric is narrower than
+the target, then stops feeding that point so its cores go to the points that
+are still converging.
+
+A point is a scenario program optionally followed by its own arguments:
+    ./tools/sequential.py basic-cache-poisoning-scenario \\
+        "crowded-cache-poisoning-scenario --ns3::ndn::SecurityToyClientApp::StartJitter=0.5" \\
+        --metrics full_delay,recovery_time --target 0.05
+"""
+
+from __future__ import print_function, division
+
+import argparse
+import multiprocessing
+import os
+import sys
+import traceback
+
+try:
+    import queue
+except ImportError:
+    import Queue as queue
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import simtools
+
+def run_one(job):
+    point, name, trace_file, args, rng_run = job
+    # always answer: an exception here would never reach the callback, and the main loop would wait forever
+    try:
+        status = simtools.run_scenario(name, trace_file, args, rng_run)
+        metrics = None
+        if status == 0:
+            metrics = simtools.trace_metrics(simtools.read_trace(trace_file))
+            os.remove(trace_file)
+    except Exception:
+        traceback.print_exc()
+        status, metrics = -1, None
+    return (point, rng_run, status, metrics)
+
+class Point:
+    "One scenario + arguments combination and the replications collected for it"
+    def __init__ (self, index, spec):
+        words = spec.split()
+        self.index = index
+        self.name = words[0]
+        self.args = words[1:]
+        self.spec = spec
+        self.samples = dict((m, []) for m in simtools.METRICS)
+        self.next_run = 1
+        self.running = 0
+        self.done = 0
+        self.failed = False
+
+    def converged (self, opts):
+        if self.failed:
+            return True
+        if self.done >= opts.max_reps:
+            return True
+        if self.done < opts.min_reps:
+            return False
+        for metric in opts.metrics:
+            values = self.samples[metric]
+            width = simtools.ci_half_width(values, opts.confidence)
+            limit = opts.target if opts.absolute else opts.target * abs(simtools.mean(values))
+            if width > limit:
+                return False
+        return True
+
+def main():
+    parser = argparse.ArgumentParser(description='Run replications until the confidence intervals are narrow enough')
+    parser.add_argument('points', metavar='point', nargs='+',
+                        help='Scenario program, optionally followed by its arguments (quote the whole point)')
+    parser.add_argument('-m', '--metrics', default=",".join(simtools.METRICS),
+                        help='Comma-separated metrics to converge (default: %(default)s)')
+    parser.add_argument('-t', '--target', type=float, default=0.05,
+                        help='Target CI half width, relative to the mean unless --absolute (default 0.05)')
+    parser.add_argument('--absolute', action='store_true', default=False,
+                        help='Treat --target as an absolute half width')
+    parser.add_argument('-c', '--confidence', type=float, default=0.95, help='Confidence level (default 0.95)')
+    parser.add_argument('--min-reps', type=int, default=3, help='Replications before testing convergence (default 3)')
+    parser.add_argument('--max-reps', type=int, default=200, help='Give up on a point after this many (default 200)')
+    parser.add_argument('-j', '--jobs', type=int, default=multiprocessing.cpu_count(),
+                        help='Replications to run in parallel (default: all cores)')
+    parser.add_argument('-o', '--output', default=os.path.join(simtools.RESULTS_DIR, 'sequential'),
+                        help='Directory for the scratch traces and the summary csv')
+    opts = parser.parse_args()
+
+    opts.metrics = opts.metrics.split(",")
+    for metric in opts.metrics:
+        if metric not in simtools.METRICS:
+            parser.error("unknown metric %s (choose from %s)" % (metric, ", ".join(simtools.METRICS)))
+
+    if not os.path.isdir(opts.output):
+        os.makedirs(opts.output)
+
+    points = [Point(i, spec) for i, spec in enumerate(opts.points)]
+    finished = queue.Queue()
+    pool = multiprocessing.Pool(opts.jobs)
+    running = 0
+
+    def launch(point):
+        trace = os.path.join(opts.output, "point-%d-run-%d-app-delays-trace.txt" % (point.index, point.next_run))
+        pool.apply_async(run_one, [(point.index, point.name, trace, point.args, point.next_run)],
+                         callback=finished.put)
+        point.next_run += 1
+        point.running += 1
+
+    try:
+        while True:
+            # hand every free core to the open point with the fewest replications in flight
+            while running < opts.jobs:
+                open_points = [p for p in points if not p.converged(opts)
+                               and p.done + p.running < opts.max_reps]
+                if not open_points:
+                    break
+                launch(min(open_points, key=lambda p: p.running))
+                running += 1
+
+            if running == 0:
+                break
+
+            index, rng_run, status, metrics = finished.get()
+            running -= 1
+            point = points[index]
+            point.running -= 1
+            if status != 0:
+                print("ERROR: %s --RngRun=%d exited with %d, dropping the point" % (point.spec, rng_run, status))
+                point.failed = True
+                continue
+
+            point.done += 1
+            for metric in simtools.METRICS:
+                point.samples[metric].append(metrics[metric])
+            if point.converged(opts) and point.running == 0:
+                print("%s: done after %d replications" % (point.spec, point.done))
+    finally:
+        pool.close()
+        pool.join()
+
+    csv = os.path.join(opts.output, "summary.csv")
+    with open(csv, "w") as f:
+        f.write("Point,Replications,Metric,Mean,HalfWidth\n")
+        for point in points:
+            for metric in opts.metrics:
+                values = point.samples[metric]
+                f.write('"%s",%d,%s,%g,%g\n' % (point.spec, point.done, metric, simtools.mean(values),
+                                                simtools.ci_half_width(values, opts.confidence)))
+
+    print("%-50s %5s %-16s %12s %12s" % ("Point", "Reps", "Metric", "Mean", "+/-"))
+    for point in points:
+        for metric in opts.metrics:
+            values = point.samples[metric]
+            print("%-50s %5d %-16s %12.6f %12.6f" % (point.spec[:50], point.done, metric, simtools.mean(values),
+                                                    simtools.ci_half_width(values, opts.confidence)))
+    print("Summary written to " + csv)
+    return 1 if any(p.failed for p in points) else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
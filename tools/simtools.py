@@ -0,0 +1,151 @@
+# -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+"""
+Shared helpers for the scripts in tools/: running scenario binaries, reading the
+app delay traces they write and turning them into the metrics we compare.
+
+Metrics (all per run, from one app delay trace):
+  full_delay     mean DelayS of the FullDelay records
+  recovery_time  mean time between the first and last FullDelay record of a
+                 (Node, AppId, SeqNo); a sequence only shows up more than once
+                 when the first answer was poisoned and the consumer pursued it
+  poisoned_ratio fraction of (Node, AppId, SeqNo) that had to be recovered
+"""
+
+from __future__ import print_function, division
+
+import math
+import os
+import subprocess
+
+BUILD_DIR = "build"
+RESULTS_DIR = "results"
+
+METRICS = ["full_delay", "recovery_time", "poisoned_ratio"]
+
+######################################################################
+# Scenarios
+
+def scenario_names():
+    "Names of every scenario in scenarios/ (same names waf gives the programs)"
+    names = []
+    for f in sorted(os.listdir("scenarios")):
+        base, ext = os.path.splitext(f)
+        if ext in (".cc", ".cpp"):
+            names.append(base)
+    return names
+
+def golden_trace(name):
+    "Committed trace for a scenario (e.g. basic-cache-poisoning-scenario -> results/basic-cache-poisoning-app-delays-trace.txt)"
+    for suffix in ("-scenario", "-example"):
+        if name.endswith(suffix):
+            name = name[:-len(suffix)]
+    return os.path.join(RESULTS_DIR, "%s-app-delays-trace.txt" % name)
+
+DRIVER = "ndn-scenarios"
+
+def scenario_command(name, args=None):
+    "Command line that runs a scenario binary (or the scenario driver, with ./waf configure --scenario-driver)"
+    program = os.path.join(".", BUILD_DIR, name)
+    driver = os.path.join(".", BUILD_DIR, DRIVER)
+    if not os.path.exists(program) and os.path.exists(driver):
+        return [driver, name] + list(args or [])
+    return [program] + list(args or [])
+
+def run_scenario(name, trace_file, args=None, rng_run=None):
+    "Runs one replication, writing its app delay trace to trace_file. Returns the exit status"
+    cmdline = scenario_command(name, args)
+    cmdline.append("--traceFile=%s" % trace_file)
+    if rng_run is not None:
+        cmdline.append("--RngRun=%d" % rng_run)
+    with open(os.devnull, "w") as devnull:
+        return subprocess.call(cmdline, stdout=devnull)
+
+######################################################################
+# Traces
+
+def read_trace(path):
+    "Reads an app delay trace into a list of dicts (one per record)"
+    rows = []
+    with open(path) as f:
+        header = f.readline().split()
+        for line in f:
+            fields = line.split()
+            if len(fields) != len(header):
+                continue
+            row = dict(zip(header, fields))
+            row["Time"] = float(row["Time"])
+            row["DelayS"] = float(row["DelayS"])
+            for key in ("Node", "AppId", "SeqNo", "RetxCount", "HopCount"):
+                row[key] = int(row[key])
+            rows.append(row)
+    return rows
+
+def trace_metrics(rows):
+    "Computes the METRICS of one run"
+    delays = []
+    times = {}
+    for row in rows:
+        if row["Type"] != "FullDelay":
+            continue
+        delays.append(row["DelayS"])
+        times.setdefault((row["Node"], row["AppId"], row["SeqNo"]), []).append(row["Time"])
+
+    recoveries = [max(t) - min(t) for t in times.values() if len(t) > 1]
+
+    return {
+        "full_delay": mean(delays),
+        "recovery_time": mean(recoveries),
+        "poisoned_ratio": len(recoveries) / len(times) if times else 0.0,
+    }
+
+######################################################################
+# Statistics
+
+def mean(values):
+    return sum(values) / len(values) if values else 0.0
+
+def variance(values):
+    "Sample variance"
+    if len(values) < 2:
+        return 0.0
+    m = mean(values)
+    return sum((v - m) ** 2 for v in values) / (len(values) - 1)
+
+def normal_quantile(p):
+    "Inverse of the standard normal CDF (Acklam's approximation)"
+    a = [-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+         1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00]
+    b = [-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+         6.680131188771972e+01, -1.328068155288572e+01]
+    c = [-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+         -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00]
+    d = [7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+         3.754408661907416e+00]
+    if p < 0.02425:
+        q = math.sqrt(-2 * math.log(p))
+        return (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) / \
+               ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1)
+    if p > 1 - 0.02425:
+        return -normal_quantile(1 - p)
+    q = p - 0.5
+    r = q * q
+    return (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*q / \
+           (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1)
+
+def t_quantile(p, df):
+    "Student t quantile (exact for df 1 and 2, Cornish-Fisher expansion above)"
+    if df == 1:
+        return math.tan(math.pi * (p - 0.5))
+    if df == 2:
+        return (2 * p - 1) / math.sqrt(2 * p * (1 - p))
+    z = normal_quantile(p)
+    return (z + (z**3 + z) / (4 * df)
+              + (5 * z**5 + 16 * z**3 + 3 * z) / (96 * df**2)
+              + (3 * z**7 + 19 * z**5 + 17 * z**3 - 15 * z) / (384 * df**3))
+
+def ci_half_width(values, confidence=0.95):
+    "Half width of the two-sided confidence interval of the mean (inf with fewer than 2 values)"
+    n = len(values)
+    if n < 2:
+        return float("inf")
+    return t_quantile(0.5 + confidence / 2, n - 1) * math.sqrt(variance(values) / n)
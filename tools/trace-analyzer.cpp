@@ -0,0 +1,427 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created by KHikami (Rachel Chu) 2017
+ **/
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+//Summarises many app delay traces at once for the R graphing step:
+//  every trace is memory-mapped and scanned by one of --threads workers (one file at a time each), and the
+//  FullDelay records are folded into per-scenario delay percentiles, retransmission counts and hop counts,
+//  written as three small CSV files to --out:
+//    delay-percentiles.csv  Scenario,Files,Samples,Mean,P50,P90,P95,P99,Max   (seconds)
+//    retx.csv               Scenario,RetxCount,Records
+//    hops.csv               Scenario,HopCount,Records
+//
+//The scenario of a trace is its file name without -app-delays-trace and the extension, or the directory
+//name for the shards of --TraceShardDir (<dir>/<trace name>/<run>-<pid>.txt).
+//
+//Traces are either the text written by ndn::AppDelayTracer or the binary variant this tool writes with
+//--to-binary <dir> (fixed 32 byte records, no parsing), which is worth it when a sweep is analysed more
+//than once.
+//
+//  ./build/trace-analyzer --out results/summary results/sweep/*.txt
+
+namespace {
+
+//binary variant: 8 byte magic, uint32 version, uint32 record size, then the records (native byte order)
+const char BINARY_MAGIC[8] = {'N', 'D', 'N', 'D', 'E', 'L', 'A', 'Y'};
+const uint32_t BINARY_VERSION = 1;
+
+struct BinaryRecord
+{
+  double time;
+  double delay; //seconds
+  uint32_t node;
+  uint32_t app;
+  uint32_t seq;
+  uint16_t retxCount;
+  uint8_t hopCount;
+  uint8_t full; //1 = FullDelay, 0 = LastDelay
+};
+
+//what one scan adds to its scenario
+struct Summary
+{
+  Summary() : files(0) {}
+
+  void
+  Merge(const Summary& other)
+  {
+    files += other.files;
+    delays.insert(delays.end(), other.delays.begin(), other.delays.end());
+    for (const auto& retx : other.retx)
+      this->retx[retx.first] += retx.second;
+    for (const auto& hops : other.hops)
+      this->hops[hops.first] += hops.second;
+  }
+
+  uint64_t files;
+  std::vector<double> delays;
+  std::map<uint32_t, uint64_t> retx;
+  std::map<uint32_t, uint64_t> hops;
+};
+
+//read-only mapping of a whole file
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string& path)
+    : m_data(nullptr)
+    , m_size(0)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+      void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        m_data = static_cast<const char*>(data);
+        m_size = info.st_size;
+        madvise(data, m_size, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+  }
+
+  ~MappedFile()
+  {
+    if (m_data != nullptr)
+      munmap(const_cast<char*>(m_data), m_size);
+  }
+
+  const char*
+  begin() const
+  {
+    return m_data;
+  }
+
+  const char*
+  end() const
+  {
+    return m_data + m_size;
+  }
+
+  bool
+  IsOpen() const
+  {
+    return m_data != nullptr;
+  }
+
+private:
+  const char* m_data;
+  size_t m_size;
+};
+
+bool
+IsBinary(const MappedFile& file)
+{
+  return file.end() - file.begin() >= 16 && std::memcmp(file.begin(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+const char*
+SkipSpace(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t'))
+    p++;
+  return p;
+}
+
+const char*
+SkipField(const char* p, const char* end)
+{
+  while (p < end && *p != ' ' && *p != '\t' && *p != '\n')
+    p++;
+  return p;
+}
+
+//unsigned decimal, stops at the first non-digit (the mapping has no terminating 0 for strtoul)
+const char*
+ParseUnsigned(const char* p, const char* end, uint64_t& value)
+{
+  value = 0;
+  while (p < end && *p >= '0' && *p <= '9')
+    value = value * 10 + (*p++ - '0');
+  return p;
+}
+
+//columns of the text trace the scan needs
+enum Column { TYPE, DELAY_US, RETX_COUNT, HOP_COUNT, COLUMNS };
+
+bool
+ScanText(const MappedFile& file, Summary& summary)
+{
+  const char* p = file.begin();
+  const char* end = file.end();
+
+  //header: find the columns by name
+  static const char* const NAMES[COLUMNS] = {"Type", "DelayUS", "RetxCount", "HopCount"};
+  int index[COLUMNS] = {-1, -1, -1, -1};
+  int columns = 0;
+  for (p = SkipSpace(p, end); p < end && *p != '\n'; p = SkipSpace(p, end), columns++) {
+    const char* field = p;
+    p = SkipField(p, end);
+    for (int c = 0; c < COLUMNS; c++) {
+      if (std::strlen(NAMES[c]) == size_t(p - field) && std::memcmp(NAMES[c], field, p - field) == 0)
+        index[c] = columns;
+    }
+  }
+  for (int c = 0; c < COLUMNS; c++) {
+    if (index[c] < 0)
+      return false;
+  }
+
+  while (p < end) {
+    p++; //newline
+    bool full = false;
+    uint64_t values[COLUMNS] = {0, 0, 0, 0};
+    int column = 0;
+    for (p = SkipSpace(p, end); p < end && *p != '\n'; p = SkipSpace(p, end), column++) {
+      const char* field = p;
+      if (column == index[TYPE]) {
+        full = *field == 'F'; //FullDelay or LastDelay
+        p = SkipField(p, end);
+        continue;
+      }
+      for (int c = DELAY_US; c < COLUMNS; c++) {
+        if (column == index[c])
+          p = ParseUnsigned(p, end, values[c]);
+      }
+      p = SkipField(p, end);
+    }
+    if (!full || column != columns)
+      continue; //LastDelay, or a cut off last line
+
+    summary.delays.push_back(values[DELAY_US] / 1e6);
+    summary.retx[values[RETX_COUNT]]++;
+    summary.hops[values[HOP_COUNT]]++;
+  }
+  return true;
+}
+
+bool
+ScanBinary(const MappedFile& file, Summary& summary)
+{
+  uint32_t header[2];
+  std::memcpy(header, file.begin() + sizeof(BINARY_MAGIC), sizeof(header));
+  if (header[0] != BINARY_VERSION || header[1] != sizeof(BinaryRecord))
+    return false;
+
+  size_t count = (file.end() - file.begin() - 16) / sizeof(BinaryRecord);
+  const char* records = file.begin() + 16;
+  for (size_t i = 0; i < count; i++) {
+    BinaryRecord record;
+    std::memcpy(&record, records + i * sizeof(BinaryRecord), sizeof(record));
+    if (!record.full)
+      continue;
+    summary.delays.push_back(record.delay);
+    summary.retx[record.retxCount]++;
+    summary.hops[record.hopCount]++;
+  }
+  return true;
+}
+
+//text trace => binary variant (all records, so it can stand in for the text trace)
+bool
+ConvertToBinary(const std::string& path)
+{
+  std::ifstream text(path.c_str());
+  std::string line;
+  std::getline(text, line); //header, the text tracer's fixed column order
+  std::FILE* out = std::fopen((path + ".bin").c_str(), "wb");
+  if (out == nullptr)
+    return false;
+  std::fwrite(BINARY_MAGIC, sizeof(BINARY_MAGIC), 1, out);
+  uint32_t header[2] = {BINARY_VERSION, sizeof(BinaryRecord)};
+  std::fwrite(header, sizeof(header), 1, out);
+
+  double time, delay;
+  uint32_t node, app, seq, retx, hops;
+  uint64_t delayUs;
+  std::string type;
+  while (text >> time >> node >> app >> seq >> type >> delay >> delayUs >> retx >> hops) {
+    BinaryRecord record = {time, delayUs / 1e6, node, app, seq, static_cast<uint16_t>(retx),
+                           static_cast<uint8_t>(hops), static_cast<uint8_t>(type == "FullDelay")};
+    std::fwrite(&record, sizeof(record), 1, out);
+  }
+  return std::fclose(out) == 0;
+}
+
+std::string
+ScenarioOf(const std::string& path)
+{
+  size_t slash = path.find_last_of('/');
+  std::string file = slash == std::string::npos ? path : path.substr(slash + 1);
+  std::string name = file.substr(0, file.find('.'));
+
+  //a shard: <run>-<pid>, the directory is the trace name
+  if (!name.empty() && name.find_first_not_of("0123456789-") == std::string::npos && slash != std::string::npos) {
+    std::string dir = path.substr(0, slash);
+    name = dir.substr(dir.find_last_of('/') + 1);
+  }
+
+  const std::string suffix = "-app-delays-trace";
+  if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+    name = name.substr(0, name.size() - suffix.size());
+  return name;
+}
+
+double
+Percentile(std::vector<double>& values, double p)
+{
+  if (values.empty())
+    return 0;
+  size_t rank = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+void
+WriteSummaries(std::map<std::string, Summary>& scenarios, const std::string& dir)
+{
+  std::ofstream delays((dir + "/delay-percentiles.csv").c_str());
+  std::ofstream retx((dir + "/retx.csv").c_str());
+  std::ofstream hops((dir + "/hops.csv").c_str());
+  delays << "Scenario,Files,Samples,Mean,P50,P90,P95,P99,Max\n";
+  retx << "Scenario,RetxCount,Records\n";
+  hops << "Scenario,HopCount,Records\n";
+
+  for (auto& scenario : scenarios) {
+    Summary& summary = scenario.second;
+    double sum = 0;
+    for (double delay : summary.delays)
+      sum += delay;
+    double mean = summary.delays.empty() ? 0 : sum / summary.delays.size();
+    double max = Percentile(summary.delays, 1.0);
+    double p99 = Percentile(summary.delays, 0.99);
+    double p95 = Percentile(summary.delays, 0.95);
+    double p90 = Percentile(summary.delays, 0.90);
+    double p50 = Percentile(summary.delays, 0.50);
+    delays << scenario.first << "," << summary.files << "," << summary.delays.size() << "," << mean << ","
+           << p50 << "," << p90 << "," << p95 << "," << p99 << "," << max << "\n";
+
+    for (const auto& count : summary.retx)
+      retx << scenario.first << "," << count.first << "," << count.second << "\n";
+    for (const auto& count : summary.hops)
+      hops << scenario.first << "," << count.first << "," << count.second << "\n";
+  }
+}
+
+void
+Usage()
+{
+  std::cerr << "usage: trace-analyzer [--out <dir>] [--threads <n>] [--to-binary] <trace> [<trace> ...]\n"
+            << "  --out <dir>     where the CSV summaries go (default: .)\n"
+            << "  --threads <n>   parallel scans (default: number of cores)\n"
+            << "  --to-binary     write <trace>.bin next to every text trace instead of summarising\n";
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  std::string outDir = ".";
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  bool toBinary = false;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--out" && i + 1 < argc)
+      outDir = argv[++i];
+    else if (arg == "--threads" && i + 1 < argc)
+      threads = std::max(1, std::atoi(argv[++i]));
+    else if (arg == "--to-binary")
+      toBinary = true;
+    else if (arg == "-h" || arg == "--help") {
+      Usage();
+      return 0;
+    }
+    else if (arg.compare(0, 2, "--") == 0) {
+      Usage();
+      return 1;
+    }
+    else
+      paths.push_back(arg);
+  }
+  if (paths.empty()) {
+    Usage();
+    return 1;
+  }
+
+  std::atomic<size_t> next(0);
+  std::atomic<size_t> failed(0);
+  std::mutex merge;
+  std::map<std::string, Summary> scenarios;
+
+  auto worker = [&] {
+    for (size_t i = next++; i < paths.size(); i = next++) {
+      MappedFile file(paths[i]);
+      if (!file.IsOpen()) {
+        failed++;
+        continue;
+      }
+
+      if (toBinary) {
+        if (IsBinary(file) || !ConvertToBinary(paths[i]))
+          failed++;
+        continue;
+      }
+
+      Summary summary;
+      summary.files = 1;
+      if (!(IsBinary(file) ? ScanBinary(file, summary) : ScanText(file, summary))) {
+        failed++;
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(merge);
+      scenarios[ScenarioOf(paths[i])].Merge(summary);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < std::min<size_t>(threads, paths.size()); t++)
+    pool.emplace_back(worker);
+  for (auto& thread : pool)
+    thread.join();
+
+  if (failed > 0)
+    std::cerr << failed << " of " << paths.size() << " traces could not be read" << std::endl;
+  if (!toBinary)
+    WriteSummaries(scenarios, outDir);
+  return failed == paths.size() ? 1 : 0;
+}